@@ -635,6 +635,16 @@ class diff_context
 				const type_or_decl_base_sptr second,
 				const diff_sptr canonical_diff);
 
+  bool
+  get_cached_suppression_verdict(const diff* d,
+				 bool& is_suppressed,
+				 bool& is_private_type) const;
+
+  void
+  cache_suppression_verdict(const diff* d,
+			    bool is_suppressed,
+			    bool is_private_type) const;
+
 public:
   diff_context();
 
@@ -726,15 +736,24 @@ public:
   void
   maybe_apply_filters(corpus_diff_sptr diff);
 
-  suppr::suppressions_type&
+  const suppr::suppressions_type&
   suppressions() const;
 
+  suppr::suppressions_type&
+  suppressions();
+
   void
   add_suppression(const suppr::suppression_sptr suppr);
 
   void
   add_suppressions(const suppr::suppressions_type& supprs);
 
+  size_t
+  num_suppression_verdict_cache_hits() const;
+
+  size_t
+  num_suppression_verdict_cache_misses() const;
+
   void
   show_leaf_changes_only(bool f);
 
@@ -853,6 +872,12 @@ public:
 
   bool show_unreachable_types();
 
+  bool
+  match_decls_by_id() const;
+
+  void
+  match_decls_by_id(bool f);
+
   bool
   show_impacted_interfaces() const;
 
@@ -887,6 +912,8 @@ public:
   compute_diff(const class_decl_sptr	first,
 	       const class_decl_sptr	second,
 	       diff_context_sptr	ctxt);
+
+  friend class diff;
 };//end struct diff_context.
 
 /// The abstraction of a change between two ABI artifacts.
@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <iterator>
 #include <memory>
 #include <ostream>
 #include <sstream>
@@ -2006,6 +2007,139 @@ compute_diff(RandomAccessOutputIterator a_begin,
 							       ses);
 }
 
+/// An element of a sequence to diff, along with its fingerprint.
+///
+/// This is the type of the elements that are actually diffed by
+/// compute_diff_with_fingerprints.
+///
+/// @tparam T the type of the element.
+template<typename T>
+struct fingerprinted_element
+{
+  size_t	fingerprint;
+  T		element;
+
+  fingerprinted_element(size_t f, const T& e)
+    : fingerprint(f), element(e)
+  {}
+}; // end struct fingerprinted_element
+
+/// An equality functor for instances of @ref fingerprinted_element.
+///
+/// The fingerprints of the two elements are compared first.  The
+/// (potentially expensive) @p EqualityFunctor is invoked only if the
+/// fingerprints are equal.
+///
+/// @tparam EqualityFunctor the functor used to compare the elements
+/// which fingerprints are equal.
+template<typename EqualityFunctor>
+struct fingerprint_eq_functor
+{
+  /// @param a the first element to compare.
+  ///
+  /// @param b the second element to compare.
+  ///
+  /// @return true iff @p a equals @p b.
+  template<typename T>
+  bool
+  operator()(const fingerprinted_element<T>& a,
+	     const fingerprinted_element<T>& b) const
+  {
+    if (a.fingerprint != b.fingerprint)
+      return false;
+    EqualityFunctor eq;
+    return eq(a.element, b.element);
+  }
+}; // end struct fingerprint_eq_functor
+
+/// Compute the shortest edit script from transforming a sequence
+/// into another one, using element fingerprints to avoid calling the
+/// equality functor as much as possible.
+///
+/// A fingerprint is computed once for each element of the two
+/// sequences.  The fingerprint must be such that two elements that
+/// are equal have the same fingerprint; two different elements can
+/// have the same fingerprint too.  The comparisons performed by the
+/// algorithm of the paper then compare the fingerprints of the
+/// elements and invoke @p EqualityFunctor only when the fingerprints
+/// are equal.
+///
+/// Also, the common prefix and the common suffix of the two sequences
+/// are skipped before running the algorithm of the paper, so that
+/// it only considers the region of the sequences that changed.
+///
+/// @tparm RandomAccessOutputIterator the type of iterators passed to
+/// this function.  It must be a random access output iterator kind.
+///
+/// @tparm EqualityFunctor the functor used to compare two elements
+/// of the sequences.
+///
+/// @tparm FingerprintFunctor a functor that takes an element of the
+/// sequences and returns its fingerprint, as a size_t.
+///
+/// @param a_begin an iterator to the beginning of the first sequence
+/// to consider.
+///
+/// @param a_end an iterator to the end of the first sequence to
+/// consider.
+///
+/// @param b_begin an iterator to the beginning of the second sequence
+/// to consider.
+///
+/// @param b_end an iterator to the end of the second sequence to
+/// consider.
+///
+/// @param ses the resulting shortest editing script.
+template<typename RandomAccessOutputIterator,
+	 typename EqualityFunctor,
+	 typename FingerprintFunctor>
+void
+compute_diff_with_fingerprints(RandomAccessOutputIterator a_begin,
+			       RandomAccessOutputIterator a_end,
+			       RandomAccessOutputIterator b_begin,
+			       RandomAccessOutputIterator b_end,
+			       edit_script& ses)
+{
+  typedef typename std::iterator_traits<RandomAccessOutputIterator>::value_type
+    value_type;
+  typedef fingerprinted_element<value_type> element_type;
+  typedef typename vector<element_type>::const_iterator element_iterator;
+
+  FingerprintFunctor fingerprint;
+  vector<element_type> a, b;
+  a.reserve(a_end - a_begin);
+  b.reserve(b_end - b_begin);
+  for (RandomAccessOutputIterator i = a_begin; i < a_end; ++i)
+    a.push_back(element_type(fingerprint(*i), *i));
+  for (RandomAccessOutputIterator i = b_begin; i < b_end; ++i)
+    b.push_back(element_type(fingerprint(*i), *i));
+
+  fingerprint_eq_functor<EqualityFunctor> eq;
+
+  // Skip the common prefix ...
+  size_t prefix_len = 0;
+  while (prefix_len < a.size()
+	 && prefix_len < b.size()
+	 && eq(a[prefix_len], b[prefix_len]))
+    ++prefix_len;
+
+  // ... and the common suffix of the two sequences.
+  size_t a_len = a.size(), b_len = b.size();
+  while (a_len > prefix_len
+	 && b_len > prefix_len
+	 && eq(a[a_len - 1], b[b_len - 1]))
+    {
+      --a_len;
+      --b_len;
+    }
+
+  compute_diff<element_iterator,
+	       fingerprint_eq_functor<EqualityFunctor> >
+    (a.begin(), a.begin() + prefix_len, a.begin() + a_len,
+     b.begin(), b.begin() + prefix_len, b.begin() + b_len,
+     ses);
+}
+
 void
 compute_lcs(const char* str1, const char* str2, int &ses_len, string& lcs);
 
@@ -184,6 +184,12 @@ set_merge_translation_units(read_context& ctxt,
 void
 set_do_log(read_context& ctxt, bool f);
 
+void
+set_exported_interfaces_only(read_context& ctxt, bool f);
+
+void
+set_corpus_cache_directory(read_context& ctxt, const string& dir);
+
 void
 set_environment(read_context& ctxt,
 		ir::environment*);
@@ -224,6 +224,9 @@ struct hash_interned_string
 /// This is where all the distinct strings represented by the interned
 /// strings leave.  The pool is the actor responsible for creating
 /// interned strings.
+///
+/// Several threads can look up and create strings in the same pool
+/// concurrently.
 class interned_string_pool
 {
   struct priv;
@@ -200,9 +200,14 @@ public:
   const config&
   get_config() const;
 
+  void
+  get_type_comparison_cache_stats(size_t& num_lookups,
+				  size_t& num_hits) const;
+
   friend class class_or_union;
   friend class class_decl;
   friend class function_type;
+  friend class type_base;
 
   friend void keep_type_alive(type_base_sptr);
 }; // end class environment
@@ -49,6 +49,9 @@ create_native_xml_read_context(const string& path, environment *env);
 read_context_sptr
 create_native_xml_read_context(std::istream* in, environment* env);
 
+read_context_sptr
+create_native_binary_read_context(const string& path, environment *env);
+
 const string&
 read_context_get_path(const read_context&);
 
@@ -60,6 +63,10 @@ corpus_sptr
 read_corpus_from_native_xml_file(const string& path,
 				 environment*  env);
 
+corpus_sptr
+read_corpus_from_native_binary_file(const string& path,
+				    environment*  env);
+
 corpus_sptr
 read_corpus_from_input(read_context& ctxt);
 
@@ -190,7 +190,11 @@ enum file_type
   FILE_TYPE_DIR,
   /// A tar archive.  The archive can be compressed with the popular
   /// compression schemes recognized by GNU tar.
-  FILE_TYPE_TAR
+  FILE_TYPE_TAR,
+  /// A native binary corpus file representing a corpus.
+  FILE_TYPE_BINARY_CORPUS,
+  /// A native binary corpus file representing a corpus group.
+  FILE_TYPE_BINARY_CORPUS_GROUP
 };
 
 /// Exit status for abidiff and abicompat tools.
@@ -69,6 +69,9 @@ set_write_parameter_names(write_context& ctxt, bool flag);
 void
 set_type_id_style(write_context& ctxt, type_id_style_kind style);
 
+void
+set_binary_output(write_context& ctxt, bool flag);
+
 /// A convenience generic function to set common options (usually used
 /// by Libabigail tools) from a generic options carrying-object, into
 /// a given @ref write_context.
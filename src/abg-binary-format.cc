@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2013-2020 Red Hat, Inc.
+
+/// @file
+///
+/// This contains the definitions of the compact binary serialization
+/// of abixml documents used by the native binary corpus format.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <libxml/parser.h>
+
+#include "abg-binary-format.h"
+
+namespace abigail
+{
+
+namespace binary_format
+{
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+
+/// An element record of the native binary corpus format.
+struct element_record
+{
+  uint32_t name;
+  uint32_t num_attributes;
+  uint32_t num_children;
+}; // end struct element_record
+
+/// An attribute record of the native binary corpus format.
+struct attribute_record
+{
+  uint32_t name;
+  uint32_t value;
+}; // end struct attribute_record
+
+/// Test if a buffer starts with the header of a native binary corpus
+/// file and get the kind of that file.
+///
+/// @param buf the buffer to consider.
+///
+/// @param len the size of @p buf.
+///
+/// @param kind output parameter.  Set to either CORPUS_KIND or
+/// CORPUS_GROUP_KIND if the function returns true.
+///
+/// @return true iff @p buf starts with the header of a native binary
+/// corpus file.
+bool
+get_file_kind(const char* buf, size_t len, char& kind)
+{
+  if (len < sizeof(MAGIC) + 1
+      || memcmp(buf, MAGIC, sizeof(MAGIC))
+      || (buf[sizeof(MAGIC)] != CORPUS_KIND
+	  && buf[sizeof(MAGIC)] != CORPUS_GROUP_KIND))
+    return false;
+
+  kind = buf[sizeof(MAGIC)];
+  return true;
+}
+
+/// The state of the serialization of an XML document into the
+/// native binary corpus format.
+struct writer
+{
+  unordered_map<string, uint32_t>	string_indexes;
+  vector<uint32_t>			string_offsets;
+  string				strings;
+  vector<element_record>		elements;
+  vector<attribute_record>		attributes;
+
+  /// Get the index of a string in the string table, adding it there
+  /// if it's not present yet.
+  ///
+  /// @param s the string to consider.
+  ///
+  /// @return the index of @p s in the string table.
+  uint32_t
+  get_string_index(const char* s)
+  {
+    std::pair<unordered_map<string, uint32_t>::iterator, bool> r =
+      string_indexes.insert(std::make_pair(string(s),
+					   string_offsets.size()));
+    if (r.second)
+      {
+	string_offsets.push_back(strings.size());
+	strings.append(s);
+	strings.push_back('\0');
+      }
+    return r.first->second;
+  }
+
+  /// Serialize an element node and its sub-tree.
+  ///
+  /// @param node the element node to serialize.
+  void
+  add_element(xmlNodePtr node)
+  {
+    size_t index = elements.size();
+    element_record e = {get_string_index(reinterpret_cast<const char*>
+					 (node->name)), 0, 0};
+    elements.push_back(e);
+
+    for (xmlAttrPtr a = node->properties; a; a = a->next)
+      {
+	xmlChar* value = xmlGetProp(node, a->name);
+	attribute_record r =
+	  {get_string_index(reinterpret_cast<const char*>(a->name)),
+	   get_string_index(value ? reinterpret_cast<char*>(value) : "")};
+	xmlFree(value);
+	attributes.push_back(r);
+	++elements[index].num_attributes;
+      }
+
+    for (xmlNodePtr n = node->children; n; n = n->next)
+      if (n->type == XML_ELEMENT_NODE)
+	{
+	  add_element(n);
+	  ++elements[index].num_children;
+	}
+  }
+}; // end struct writer
+
+/// Write a 32 bits integer to an output stream.
+///
+/// @param out the output stream to write to.
+///
+/// @param v the integer to write.
+static void
+write_uint32(std::ostream& out, uint32_t v)
+{out.write(reinterpret_cast<const char*>(&v), sizeof(v));}
+
+/// Serialize an abixml document in the native binary corpus format.
+///
+/// Only elements and their attributes are serialized; comments and
+/// blank text nodes are dropped.
+///
+/// @param xml the abixml document to serialize.  Its root element
+/// must be either 'abi-corpus' or 'abi-corpus-group'.
+///
+/// @param out the output stream to write the result to.
+///
+/// @return true upon successful completion.
+bool
+write_xml_document_as_binary(const string& xml, std::ostream& out)
+{
+  xmlDocPtr doc = xmlReadMemory(xml.data(), xml.size(), "", 0,
+				XML_PARSE_NOBLANKS | XML_PARSE_HUGE);
+  if (!doc)
+    return false;
+
+  xmlNodePtr root = xmlDocGetRootElement(doc);
+  char kind = 0;
+  if (root && xmlStrEqual(root->name, BAD_CAST("abi-corpus")))
+    kind = CORPUS_KIND;
+  else if (root && xmlStrEqual(root->name, BAD_CAST("abi-corpus-group")))
+    kind = CORPUS_GROUP_KIND;
+  if (!kind)
+    {
+      xmlFreeDoc(doc);
+      return false;
+    }
+
+  writer w;
+  w.add_element(root);
+  xmlFreeDoc(doc);
+
+  while (w.strings.size() % 4)
+    w.strings.push_back('\0');
+
+  out.write(MAGIC, sizeof(MAGIC));
+  out.put(kind);
+  out.put('\0');
+  write_uint32(out, FORMAT_VERSION);
+  write_uint32(out, BYTE_ORDER_MARK);
+  write_uint32(out, w.string_offsets.size());
+  write_uint32(out, w.strings.size());
+  write_uint32(out, w.elements.size());
+  write_uint32(out, w.attributes.size());
+
+  out.write(reinterpret_cast<const char*>(w.string_offsets.data()),
+	    w.string_offsets.size() * sizeof(uint32_t));
+  out.write(w.strings.data(), w.strings.size());
+  out.write(reinterpret_cast<const char*>(w.elements.data()),
+	    w.elements.size() * sizeof(element_record));
+  out.write(reinterpret_cast<const char*>(w.attributes.data()),
+	    w.attributes.size() * sizeof(attribute_record));
+
+  return out.good();
+}
+
+/// A read-only memory mapping of a whole file.
+struct mapped_file
+{
+  const char*	data;
+  size_t	size;
+
+  mapped_file()
+    : data(), size()
+  {}
+
+  /// Map a file in memory.
+  ///
+  /// @param path the path to the file to map.
+  ///
+  /// @return true iff the file could be mapped.
+  bool
+  map(const string& path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    struct stat s;
+    bool is_ok = fstat(fd, &s) == 0 && s.st_size > 0;
+    if (is_ok)
+      {
+	void* p = mmap(0, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED)
+	  is_ok = false;
+	else
+	  {
+	    data = static_cast<const char*>(p);
+	    size = s.st_size;
+	  }
+      }
+    close(fd);
+    return is_ok;
+  }
+
+  ~mapped_file()
+  {
+    if (data)
+      munmap(const_cast<char*>(data), size);
+  }
+}; // end struct mapped_file
+
+/// Add an attribute which name and value are interned in the
+/// dictionary of a document to the end of the attribute list of an
+/// element node.
+///
+/// xmlNewProp copies the value of the attribute into a new text node
+/// and walks the list of attributes of the element to append the new
+/// one.  Like the SAX2 tree builder of libxml2, this rather makes the
+/// text node point to the interned value, which xmlFreeDoc then
+/// leaves alone, and appends the attribute in constant time.
+///
+/// @param doc the document to consider.  It must have a dictionary.
+///
+/// @param node the element node to add the attribute to.
+///
+/// @param last the last attribute of @p node, or nil if it has none.
+///
+/// @param name the name of the attribute, interned in the dictionary
+/// of @p doc.
+///
+/// @param value the value of the attribute, interned in the
+/// dictionary of @p doc.
+///
+/// @return the new attribute.
+static xmlAttrPtr
+add_interned_attribute(xmlDocPtr doc, xmlNodePtr node, xmlAttrPtr last,
+		       const xmlChar* name, const xmlChar* value)
+{
+  xmlAttrPtr attr = xmlNewDocProp(doc, name, 0);
+  xmlNodePtr text = xmlNewDocText(doc, 0);
+  text->content = const_cast<xmlChar*>(value);
+  text->parent = reinterpret_cast<xmlNodePtr>(attr);
+  attr->children = attr->last = text;
+  attr->parent = node;
+  if (last)
+    {
+      last->next = attr;
+      attr->prev = last;
+    }
+  else
+    node->properties = attr;
+  return attr;
+}
+
+/// Build the XML document encoded by a file in the native binary
+/// corpus format.
+///
+/// The file is mapped in memory.  All the records are validated
+/// before they are used, so a truncated or otherwise corrupted file
+/// makes the function fail rather than crash.
+///
+/// @param path the path to the file to read.
+///
+/// @return the resulting XML document, or nil if the file could not
+/// be read or is not a valid native binary corpus file.  The caller
+/// owns the document and must free it using xmlFreeDoc.
+xmlDocPtr
+read_binary_as_xml_document(const string& path)
+{
+  mapped_file file;
+  if (!file.map(path) || file.size < HEADER_SIZE)
+    return 0;
+
+  char kind = 0;
+  if (!get_file_kind(file.data, file.size, kind))
+    return 0;
+
+  const uint32_t* header =
+    reinterpret_cast<const uint32_t*>(file.data + sizeof(MAGIC) + 2);
+  if (header[0] != FORMAT_VERSION || header[1] != BYTE_ORDER_MARK)
+    return 0;
+
+  uint64_t num_strings = header[2], strings_size = header[3],
+    num_elements = header[4], num_attributes = header[5];
+  uint64_t expected_size = HEADER_SIZE
+    + num_strings * sizeof(uint32_t)
+    + strings_size
+    + num_elements * sizeof(element_record)
+    + num_attributes * sizeof(attribute_record);
+  if (expected_size != file.size
+      || strings_size % 4
+      || num_elements == 0)
+    return 0;
+
+  const uint32_t* string_offsets =
+    reinterpret_cast<const uint32_t*>(file.data + HEADER_SIZE);
+  const char* strings =
+    reinterpret_cast<const char*>(string_offsets + num_strings);
+  const element_record* elements =
+    reinterpret_cast<const element_record*>(strings + strings_size);
+  const attribute_record* attributes =
+    reinterpret_cast<const attribute_record*>(elements + num_elements);
+
+  // The string table must be properly terminated for the offsets
+  // below to designate NUL-terminated strings.
+  if (strings_size == 0 || strings[strings_size - 1] != '\0')
+    return 0;
+
+  xmlDocPtr doc = xmlNewDoc(BAD_CAST("1.0"));
+  doc->dict = xmlDictCreate();
+
+  // Intern each string of the string table only once.
+  vector<const xmlChar*> dict_strings(num_strings);
+  for (uint64_t i = 0; i < num_strings; ++i)
+    {
+      if (string_offsets[i] >= strings_size)
+	{
+	  xmlFreeDoc(doc);
+	  return 0;
+	}
+      dict_strings[i] = xmlDictLookup(doc->dict,
+				      BAD_CAST(strings + string_offsets[i]),
+				      -1);
+    }
+
+  // The element records are in document order; this stack holds the
+  // elements which children are not all built yet, along with the
+  // number of their children that remain to be built.
+  vector<std::pair<xmlNodePtr, uint32_t> > parents;
+  uint64_t attribute_index = 0;
+  bool is_ok = true;
+  for (uint64_t i = 0; is_ok && i < num_elements; ++i)
+    {
+      const element_record& e = elements[i];
+      if (e.name >= num_strings
+	  || attribute_index + e.num_attributes > num_attributes
+	  || (i > 0 && parents.empty()))
+	{
+	  is_ok = false;
+	  break;
+	}
+
+      xmlNodePtr node =
+	xmlNewDocNodeEatName(doc, 0,
+			     const_cast<xmlChar*>(dict_strings[e.name]),
+			     0);
+      if (parents.empty())
+	xmlDocSetRootElement(doc, node);
+      else
+	{
+	  xmlAddChild(parents.back().first, node);
+	  if (--parents.back().second == 0)
+	    parents.pop_back();
+	}
+
+      xmlAttrPtr last_attribute = 0;
+      for (uint32_t j = 0; j < e.num_attributes; ++j, ++attribute_index)
+	{
+	  const attribute_record& a = attributes[attribute_index];
+	  if (a.name >= num_strings || a.value >= num_strings)
+	    {
+	      is_ok = false;
+	      break;
+	    }
+	  last_attribute = add_interned_attribute(doc, node, last_attribute,
+						  dict_strings[a.name],
+						  dict_strings[a.value]);
+	}
+
+      if (e.num_children)
+	parents.push_back(std::make_pair(node, e.num_children));
+    }
+
+  if (!is_ok || !parents.empty() || attribute_index != num_attributes)
+    {
+      xmlFreeDoc(doc);
+      return 0;
+    }
+
+  return doc;
+}
+
+}// end namespace binary_format
+}// end namespace abigail
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2013-2020 Red Hat, Inc.
+
+/// @file
+///
+/// This contains the declarations of the compact binary serialization
+/// of abixml documents used by the native binary corpus format.
+///
+/// A native binary corpus file encodes the element tree of an abixml
+/// document, which root is either an 'abi-corpus' or an
+/// 'abi-corpus-group' element.  All the integers are 32 bits wide
+/// and stored in the byte order of the machine that wrote the file.
+/// The layout of the file is:
+///
+///   - A header of HEADER_SIZE bytes made of:
+///
+///       - the 6 bytes of MAGIC;
+///       - one byte which is either CORPUS_KIND or CORPUS_GROUP_KIND;
+///       - one padding byte;
+///       - the version of the format, i.e, FORMAT_VERSION;
+///       - the BYTE_ORDER_MARK, as written by the producer;
+///       - the number of strings of the string table;
+///       - the size in bytes of the characters of the string table;
+///       - the number of element records;
+///       - the number of attribute records.
+///
+///   - The string table: the offsets of each string into the
+///     characters of the string table, followed by those characters.
+///     Each string is terminated by a NUL character and the size of
+///     the characters is padded to a multiple of 4.  Each distinct
+///     element name, attribute name or attribute value is stored
+///     only once in the string table and is referenced by its index
+///     everywhere else.
+///
+///   - The element records, in document order.  Each record is made
+///     of the index of the name of the element, its number of
+///     attributes and its number of child elements.
+///
+///   - The attribute records of all the elements, in the order of
+///     the element records.  Each record is made of the index of the
+///     name of the attribute and the index of its value.
+///
+/// As everything is either a fixed-size record or an index, the file
+/// is meant to be mapped in memory and used in place.
+
+#ifndef __ABG_BINARY_FORMAT_H__
+#define __ABG_BINARY_FORMAT_H__
+
+#include <libxml/tree.h>
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace abigail
+{
+
+/// The compact binary serialization of abixml documents.
+namespace binary_format
+{
+
+/// The magic bytes a native binary corpus file starts with.
+const char MAGIC[] = {'A', 'B', 'I', 'B', 'I', 'N'};
+
+/// The kind of a file which root element is 'abi-corpus'.
+const char CORPUS_KIND = 'C';
+
+/// The kind of a file which root element is 'abi-corpus-group'.
+const char CORPUS_GROUP_KIND = 'G';
+
+/// The version of the format produced by this implementation.
+const uint32_t FORMAT_VERSION = 1;
+
+/// The value written in the header to detect files produced on a
+/// machine with a different byte order.
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// The size of the header of the format, in bytes.
+const size_t HEADER_SIZE = 32;
+
+bool
+get_file_kind(const char* buf, size_t len, char& kind);
+
+bool
+write_xml_document_as_binary(const std::string& xml, std::ostream& out);
+
+xmlDocPtr
+read_binary_as_xml_document(const std::string& path);
+
+}// end namespace binary_format
+}// end namespace abigail
+
+#endif // __ABG_BINARY_FORMAT_H__
@@ -165,6 +165,30 @@ typedef unordered_map<const diff*, artifact_sptr_set_type,
 		      diff_hash, diff_equal>
 diff_artifact_set_map_type;
 
+/// The verdict of the evaluation of the suppression specifications
+/// of a @ref diff_context against a given diff node.
+struct suppression_verdict
+{
+  bool is_suppressed;
+  bool is_private_type;
+
+  suppression_verdict()
+    : is_suppressed(),
+      is_private_type()
+  {}
+
+  suppression_verdict(bool suppressed, bool private_type)
+    : is_suppressed(suppressed),
+      is_private_type(private_type)
+  {}
+};// end struct suppression_verdict
+
+/// A convenience typedef for a map which key is a canonical diff node
+/// and which value is the verdict of the suppression specifications
+/// evaluated against that diff node.
+typedef unordered_map<const diff*, suppression_verdict>
+diff_suppression_verdict_map;
+
 /// The private member (pimpl) for @ref diff_context.
 struct diff_context::priv
 {
@@ -175,6 +199,16 @@ struct diff_context::priv
   vector<diff_sptr>			canonical_diffs;
   vector<filtering::filter_base_sptr>	filters_;
   suppressions_type			suppressions_;
+  // Incremented each time the suppressions can be changed, that is,
+  // each time diff_context::add_suppression{s} or the non-const
+  // diff_context::suppressions() are called.
+  size_t				suppressions_generation_;
+  diff_suppression_verdict_map		suppression_verdicts_;
+  // The generation of the suppressions that the verdicts of
+  // suppression_verdicts_ were computed for.
+  size_t				suppression_verdicts_generation_;
+  size_t				num_suppression_verdict_cache_hits_;
+  size_t				num_suppression_verdict_cache_misses_;
   pointer_map				visited_diff_nodes_;
   corpus_diff_sptr			corpus_diff_;
   ostream*				default_output_stream_;
@@ -202,11 +236,16 @@ struct diff_context::priv
   bool					show_added_syms_unreferenced_by_di_;
   bool					show_unreachable_types_;
   bool					show_impacted_interfaces_;
+  bool					match_decls_by_id_;
   bool					dump_diff_tree_;
 
   priv()
     : allowed_category_(EVERYTHING_CATEGORY),
       reporter_(),
+      suppressions_generation_(),
+      suppression_verdicts_generation_(),
+      num_suppression_verdict_cache_hits_(),
+      num_suppression_verdict_cache_misses_(),
       default_output_stream_(),
       error_output_stream_(),
       leaf_changes_only_(),
@@ -232,8 +271,25 @@ struct diff_context::priv
       show_added_syms_unreferenced_by_di_(true),
       show_unreachable_types_(false),
       show_impacted_interfaces_(true),
+      match_decls_by_id_(true),
       dump_diff_tree_()
    {}
+
+  /// Drop the cached suppression verdicts if the set of suppressions
+  /// might have changed since they were computed.
+  ///
+  /// The set of suppressions can be changed either through
+  /// diff_context::add_suppression{s} or through the reference
+  /// returned by the non-const diff_context::suppressions().
+  void
+  maybe_invalidate_suppression_verdicts()
+  {
+    if (suppression_verdicts_generation_ != suppressions_generation_)
+      {
+	suppression_verdicts_.clear();
+	suppression_verdicts_generation_ = suppressions_generation_;
+      }
+  }
 };// end struct diff_context::priv
 
 struct type_diff_base::priv
@@ -944,6 +1000,57 @@ struct parm_comp
   {return operator()(*l, *r);}
 }; // end struct parm_comp
 
+/// Functor that computes the fingerprint of a function parameter, for
+/// the purpose of diffing sequences of parameters with
+/// diff_utils::compute_diff_with_fingerprints.
+///
+/// Two parameters can be equal only if they have the same index and
+/// the same variadic-ness, so these make up the fingerprint.
+struct parm_fingerprint
+{
+  /// @param p the parameter to consider.
+  ///
+  /// @return the fingerprint of @p p.
+  size_t
+  operator()(const function_decl::parameter_sptr& p) const
+  {
+    if (!p)
+      return 0;
+    return hashing::combine_hashes(p->get_index(),
+				   p->get_variadic_marker());
+  }
+}; // end struct parm_fingerprint
+
+/// Functor that computes the fingerprint of a member function, for
+/// the purpose of diffing sequences of member functions with
+/// diff_utils::compute_diff_with_fingerprints.
+///
+/// Two member functions can be equal only if they have the same
+/// vtable offset, the same const-ness and constructor/destructor-ness
+/// and if they both have an underlying ELF symbol or both have none,
+/// so these make up the fingerprint.  The name and the symbol of the
+/// member functions are not part of it because equals() considers
+/// two member functions whose symbols are aliases as equal, even if
+/// their names differ.
+struct mem_fn_fingerprint
+{
+  /// @param f the member function to consider.
+  ///
+  /// @return the fingerprint of @p f.
+  size_t
+  operator()(const method_decl_sptr& f) const
+  {
+    if (!f)
+      return 0;
+    size_t flags = (f->get_symbol() ? 1 : 0)
+      | (get_member_function_is_const(*f) ? 2 : 0)
+      | (get_member_function_is_ctor(*f) ? 4 : 0)
+      | (get_member_function_is_dtor(*f) ? 8 : 0);
+    return hashing::combine_hashes(get_member_function_vtable_offset(*f),
+				   flags);
+  }
+}; // end struct mem_fn_fingerprint
+
 /// A functor to compare instances of @ref var_decl base on their
 /// qualified names.
 struct var_comp
@@ -1453,6 +1560,17 @@ get_fn_decl_or_var_decl_diff_ancestor(const diff *);
 bool
 is_diff_of_global_decls(const diff*);
 
+bool
+filters_can_be_applied_in_one_walk(const filtering::filters& filters);
+
+void
+apply_filters_and_propagate_categories(const filtering::filters& filters,
+				       diff* diff_tree);
+
+void
+apply_filters_and_propagate_categories(const filtering::filters& filters,
+				       corpus_diff* diff_tree);
+
 } // end namespace comparison
 
 } // namespace abigail
@@ -1359,6 +1359,12 @@ diff_context::maybe_apply_filters(diff_sptr diff)
   if (!diff->has_changes())
     return;
 
+  if (filters_can_be_applied_in_one_walk(diff_filters()))
+    {
+      apply_filters_and_propagate_categories(diff_filters(), diff.get());
+      return;
+    }
+
   for (filtering::filters::const_iterator i = diff_filters().begin();
        i != diff_filters().end();
        ++i)
@@ -1366,8 +1372,7 @@ diff_context::maybe_apply_filters(diff_sptr diff)
       filtering::apply_filter(*i, diff);
       propagate_categories(diff);
     }
-
- }
+}
 
 /// Apply the diff filters to the diff nodes of a @ref corpus_diff
 /// instance.
@@ -1384,6 +1389,12 @@ diff_context::maybe_apply_filters(corpus_diff_sptr diff)
   if (!diff || !diff->has_changes())
     return;
 
+  if (filters_can_be_applied_in_one_walk(diff_filters()))
+    {
+      apply_filters_and_propagate_categories(diff_filters(), diff.get());
+      return;
+    }
+
   for (filtering::filters::const_iterator i = diff_filters().begin();
        i != diff_filters().end();
        ++i)
@@ -1396,11 +1407,45 @@ diff_context::maybe_apply_filters(corpus_diff_sptr diff)
 /// Getter for the vector of suppressions that specify which diff node
 /// reports should be dropped on the floor.
 ///
+/// The suppression specifications must not be modified through the
+/// returned vector, as the verdicts of the suppression specifications
+/// against diff nodes are cached by this context.
+///
 /// @return the set of suppressions.
-suppressions_type&
+const suppressions_type&
 diff_context::suppressions() const
 {return priv_->suppressions_;}
 
+/// Getter for the vector of suppressions that specify which diff node
+/// reports should be dropped on the floor.
+///
+/// As the returned vector can be used to change the set of
+/// suppressions, this drops the verdicts of the suppression
+/// specifications against diff nodes that were cached by this
+/// context.  The returned reference must thus not be kept around to
+/// change the suppressions once they have been evaluated again.
+///
+/// @return the set of suppressions.
+suppressions_type&
+diff_context::suppressions()
+{
+  ++priv_->suppressions_generation_;
+  return priv_->suppressions_;
+}
+
+/// Getter for the vector of suppressions of a diff context, for the
+/// code that only reads it.
+///
+/// Unlike the non-const diff_context::suppressions, this doesn't drop
+/// the suppression verdicts cached by the context.
+///
+/// @param ctxt the diff context to consider.
+///
+/// @return the set of suppressions of @p ctxt.
+static const suppressions_type&
+const_suppressions(const diff_context_sptr& ctxt)
+{return static_cast<const diff_context&>(*ctxt).suppressions();}
+
 /// Add a new suppression specification that specifies which diff node
 /// reports should be dropped on the floor.
 ///
@@ -1408,7 +1453,10 @@ diff_context::suppressions() const
 /// existing set of suppressions specifications of the diff context.
 void
 diff_context::add_suppression(const suppression_sptr suppr)
-{priv_->suppressions_.push_back(suppr);}
+{
+  priv_->suppressions_.push_back(suppr);
+  ++priv_->suppressions_generation_;
+}
 
 /// Add new suppression specifications that specify which diff node
 /// reports should be dropped on the floor.
@@ -1420,6 +1468,90 @@ diff_context::add_suppressions(const suppressions_type& supprs)
 {
   priv_->suppressions_.insert(priv_->suppressions_.end(),
 			      supprs.begin(), supprs.end());
+  ++priv_->suppressions_generation_;
+}
+
+/// Getter of the number of times the verdict of the suppression
+/// specifications against a diff node was found in the cache of
+/// suppression verdicts of this context.
+///
+/// @return the number of cache hits.
+size_t
+diff_context::num_suppression_verdict_cache_hits() const
+{return priv_->num_suppression_verdict_cache_hits_;}
+
+/// Getter of the number of times the suppression specifications had
+/// to be evaluated against a diff node because their verdict was not
+/// in the cache of suppression verdicts of this context.
+///
+/// @return the number of cache misses.
+size_t
+diff_context::num_suppression_verdict_cache_misses() const
+{return priv_->num_suppression_verdict_cache_misses_;}
+
+/// Look up the cached verdict of the suppression specifications of
+/// this context against a given diff node.
+///
+/// All the diff nodes of a given class of equivalence have the same
+/// subjects, so the verdict is cached for their canonical diff node.
+///
+/// @param d the diff node to consider.
+///
+/// @param is_suppressed out parameter.  Set to true iff @p d is
+/// suppressed.  This is set only if the function returns true.
+///
+/// @param is_private_type out parameter.  Set to true iff @p d is
+/// suppressed by a private type suppression specification.  This is
+/// set only if the function returns true.
+///
+/// @return true iff a verdict was found in the cache for @p d.
+bool
+diff_context::get_cached_suppression_verdict(const diff* d,
+					     bool& is_suppressed,
+					     bool& is_private_type) const
+{
+  priv_->maybe_invalidate_suppression_verdicts();
+
+  const diff* canonical = d->get_canonical_diff();
+  if (!canonical)
+    canonical = d;
+
+  diff_suppression_verdict_map::const_iterator i =
+    priv_->suppression_verdicts_.find(canonical);
+  if (i == priv_->suppression_verdicts_.end())
+    {
+      ++priv_->num_suppression_verdict_cache_misses_;
+      return false;
+    }
+
+  ++priv_->num_suppression_verdict_cache_hits_;
+  is_suppressed = i->second.is_suppressed;
+  is_private_type = i->second.is_private_type;
+  return true;
+}
+
+/// Cache the verdict of the suppression specifications of this
+/// context against a given diff node.
+///
+/// @param d the diff node to consider.
+///
+/// @param is_suppressed true iff @p d is suppressed.
+///
+/// @param is_private_type true iff @p d is suppressed by a private
+/// type suppression specification.
+void
+diff_context::cache_suppression_verdict(const diff* d,
+					bool is_suppressed,
+					bool is_private_type) const
+{
+  priv_->maybe_invalidate_suppression_verdicts();
+
+  const diff* canonical = d->get_canonical_diff();
+  if (!canonical)
+    canonical = d;
+
+  priv_->suppression_verdicts_[canonical] =
+    suppression_verdict(is_suppressed, is_private_type);
 }
 
 /// Set the flag that indicates if the diff using this context should
@@ -1733,6 +1865,34 @@ bool
 diff_context::show_unreachable_types()
 {return priv_->show_unreachable_types_;}
 
+/// Getter of the flag that says if the functions, variables and
+/// symbols of two corpora are to be matched by their ID when
+/// comparing the corpora.
+///
+/// When that flag is set, the functions (and variables, and symbols)
+/// of the two corpora are joined on their ID using hash tables and
+/// only the pairs of artifacts that have the same ID are compared.
+/// Otherwise, an edit script is computed between the sequences of
+/// functions (resp. variables and symbols) of the two corpora, which
+/// is much more expensive for big corpora.  Both methods lead to the
+/// same corpus diff.
+///
+/// @return true iff the artifacts of the corpora are to be matched
+/// by ID.
+bool
+diff_context::match_decls_by_id() const
+{return priv_->match_decls_by_id_;}
+
+/// Setter of the flag that says if the functions, variables and
+/// symbols of two corpora are to be matched by their ID when
+/// comparing the corpora.
+///
+/// @param f true iff the artifacts of the corpora are to be matched
+/// by ID.
+void
+diff_context::match_decls_by_id(bool f)
+{priv_->match_decls_by_id_ = f;}
+
 /// Getter of the flag that indicates if the leaf reporter should
 /// display a summary of the interfaces impacted by a given leaf
 /// change or not.
@@ -2377,19 +2537,31 @@ diff::is_suppressed() const
 bool
 diff::is_suppressed(bool &is_private_type) const
 {
-  const suppressions_type& suppressions = context()->suppressions();
-  for (suppressions_type::const_iterator i = suppressions.begin();
-       i != suppressions.end();
-       ++i)
+  diff_context_sptr ctxt = context();
+  const suppressions_type& suppressions = const_suppressions(ctxt);
+  if (suppressions.empty())
+    return false;
+
+  bool suppressed = false, private_type = false;
+  if (!ctxt->get_cached_suppression_verdict(this, suppressed, private_type))
     {
-      if ((*i)->suppresses_diff(this))
+      for (suppressions_type::const_iterator i = suppressions.begin();
+	   i != suppressions.end();
+	   ++i)
 	{
-	  if (is_private_type_suppr_spec(*i))
-	    is_private_type = true;
-	  return true;
+	  if ((*i)->suppresses_diff(this))
+	    {
+	      suppressed = true;
+	      private_type = is_private_type_suppr_spec(*i);
+	      break;
+	    }
 	}
+      ctxt->cache_suppression_verdict(this, suppressed, private_type);
     }
-  return false;
+
+  if (private_type)
+    is_private_type = true;
+  return suppressed;
 }
 
 /// Test if this diff tree node should be reported.
@@ -5751,11 +5923,14 @@ compute_diff(const class_decl_sptr	first,
 	       changes->data_members_changes());
 
   // Compare virtual member functions
-  compute_diff(f->get_virtual_mem_fns().begin(),
-	       f->get_virtual_mem_fns().end(),
-	       s->get_virtual_mem_fns().begin(),
-	       s->get_virtual_mem_fns().end(),
-	       changes->member_fns_changes());
+  diff_utils::compute_diff_with_fingerprints
+    <class_or_union::member_functions::const_iterator,
+     diff_utils::default_eq_functor,
+     mem_fn_fingerprint>(f->get_virtual_mem_fns().begin(),
+			 f->get_virtual_mem_fns().end(),
+			 s->get_virtual_mem_fns().begin(),
+			 s->get_virtual_mem_fns().end(),
+			 changes->member_fns_changes());
 
   // Compare member function templates
   compute_diff(f->get_member_function_templates().begin(),
@@ -7064,11 +7239,14 @@ compute_diff(const function_type_sptr	first,
 
   function_type_diff_sptr result(new function_type_diff(first, second, ctxt));
 
-  diff_utils::compute_diff(first->get_first_parm(),
-			   first->get_parameters().end(),
-			   second->get_first_parm(),
-			   second->get_parameters().end(),
-			   result->priv_->parm_changes_);
+  diff_utils::compute_diff_with_fingerprints
+    <function_decl::parameters::const_iterator,
+     diff_utils::default_eq_functor,
+     parm_fingerprint>(first->get_first_parm(),
+		       first->get_parameters().end(),
+		       second->get_first_parm(),
+		       second->get_parameters().end(),
+		       result->priv_->parm_changes_);
 
   result->ensure_lookup_tables_populated();
 
@@ -8932,11 +9110,12 @@ corpus_diff::priv::ensure_lookup_tables_populated()
 	      deleted_fns_.find(n);
 	    if (j != deleted_fns_.end())
 	      {
-		function_decl_sptr f(j->second, noop_deleter());
-		function_decl_sptr s(added_fn, noop_deleter());
-		function_decl_diff_sptr d = compute_diff(f, s, ctxt);
 		if (*j->second != *added_fn)
-		  changed_fns_map_[j->first] = d;
+		  {
+		    function_decl_sptr f(j->second, noop_deleter());
+		    function_decl_sptr s(added_fn, noop_deleter());
+		    changed_fns_map_[j->first] = compute_diff(f, s, ctxt);
+		  }
 		deleted_fns_.erase(j);
 	      }
 	    else
@@ -9363,7 +9542,7 @@ corpus_diff::priv::apply_supprs_to_added_removed_fns_vars_unreachable_types()
 {
   diff_context_sptr ctxt = get_context();
 
-  const suppressions_type& suppressions = ctxt->suppressions();
+  const suppressions_type& suppressions = const_suppressions(ctxt);
   for (suppressions_type::const_iterator i = suppressions.begin();
        i != suppressions.end();
        ++i)
@@ -11055,6 +11234,140 @@ corpus_diff::traverse(diff_node_visitor& v)
   return true;
 }
 
+/// Get the ID of a function, as used to match the functions of two
+/// corpora.
+///
+/// @param fn the function to consider.
+///
+/// @return the ID of @p fn.
+static string
+get_artifact_id(const function_decl* fn)
+{return fn->get_id();}
+
+/// Get the ID of a variable, as used to match the variables of two
+/// corpora.
+///
+/// @param var the variable to consider.
+///
+/// @return the ID of @p var.
+static string
+get_artifact_id(const var_decl* var)
+{return var->get_id();}
+
+/// Get the ID of an ELF symbol, as used to match the symbols of two
+/// corpora.
+///
+/// @param sym the symbol to consider.
+///
+/// @return the ID of @p sym.
+static string
+get_artifact_id(const elf_symbol_sptr& sym)
+{return sym->get_id_string();}
+
+/// Test if two functions or variables matched on their ID have types
+/// with different canonical types.
+///
+/// @param f the first artifact to consider.
+///
+/// @param s the second artifact to consider.
+///
+/// @return true iff the types of @p f and @p s are canonicalized and
+/// their canonical types are different, in which case @p f and @p s
+/// are known to be different without comparing them.
+template<typename T>
+static bool
+canonical_types_differ(const T* f, const T* s)
+{
+  const type_base *t0 = f->get_naked_type(), *t1 = s->get_naked_type();
+  if (!t0 || !t1)
+    return false;
+
+  const type_base *c0 = t0->get_naked_canonical_type(),
+    *c1 = t1->get_naked_canonical_type();
+  return c0 && c1 && c0 != c1;
+}
+
+/// Overload of canonical_types_differ for ELF symbols, which have no
+/// type.
+///
+/// @return false.
+static bool
+canonical_types_differ(const elf_symbol_sptr&, const elf_symbol_sptr&)
+{return false;}
+
+/// Compute an edit script between two sequences of artifacts of two
+/// corpora by matching the artifacts on their ID.
+///
+/// The artifacts of the first sequence are put in a hash table keyed
+/// by their ID.  Each artifact of the second sequence is then
+/// matched against the artifacts of the first sequence that have the
+/// same ID and which are not matched yet.  A pair whose types have
+/// different canonical types is known to be different and is not
+/// compared further; the other pairs are compared using deep
+/// equality, where comparing their types boils down to comparing
+/// their canonical types, so only their decl-level properties are
+/// really compared.  The artifacts of the second
+/// sequence that are not equal to any artifact of the first
+/// sequence are recorded as insertions; the artifacts of the first
+/// sequence that are not matched are recorded as deletions.
+///
+/// Unlike the edit script computed by diff_utils::compute_diff, this
+/// one is not minimal with respect to moved artifacts: an artifact
+/// that moved is seen as both deleted and inserted.  This is fine
+/// for corpus_diff::priv::ensure_lookup_tables_populated which
+/// matches deletions and insertions by ID anyway.
+///
+/// @param first the first sequence of artifacts.
+///
+/// @param second the second sequence of artifacts.
+///
+/// @param e the resulting edit script.
+template<typename T>
+static void
+compute_diff_by_id(const vector<T>& first,
+		   const vector<T>& second,
+		   edit_script& e)
+{
+  diff_utils::deep_ptr_eq_functor eq;
+
+  std::unordered_map<string, vector<unsigned> > first_artifacts;
+  for (unsigned i = 0; i < first.size(); ++i)
+    first_artifacts[get_artifact_id(first[i])].push_back(i);
+
+  vector<bool> matched(first.size(), false);
+  int last_matched = -1;
+  for (unsigned j = 0; j < second.size(); ++j)
+    {
+      bool found = false;
+      std::unordered_map<string, vector<unsigned> >::const_iterator it =
+	first_artifacts.find(get_artifact_id(second[j]));
+      if (it != first_artifacts.end())
+	for (vector<unsigned>::const_iterator i = it->second.begin();
+	     i != it->second.end();
+	     ++i)
+	  if (!matched[*i]
+	      && !canonical_types_differ(first[*i], second[j])
+	      && eq(first[*i], second[j]))
+	    {
+	      matched[*i] = true;
+	      last_matched = *i;
+	      found = true;
+	      break;
+	    }
+
+      if (!found)
+	{
+	  insertion ins(last_matched);
+	  ins.inserted_indexes().push_back(j);
+	  e.insertions().push_back(ins);
+	}
+    }
+
+  for (unsigned i = 0; i < first.size(); ++i)
+    if (!matched[i])
+      e.deletions().push_back(deletion(i));
+}
+
 /// Compute the diff between two instances of @ref corpus.
 ///
 /// Note that the two corpora must have been created in the same @ref
@@ -11096,36 +11409,59 @@ compute_diff(const corpus_sptr	f,
   r->priv_->architectures_equal_ =
     f->get_architecture_name() == s->get_architecture_name();
 
-  // Compute the diff of publicly defined and exported functions
-  diff_utils::compute_diff<fns_it_type, eq_type>(f->get_functions().begin(),
-						 f->get_functions().end(),
-						 s->get_functions().begin(),
-						 s->get_functions().end(),
-						 r->priv_->fns_edit_script_);
-
-  // Compute the diff of publicly defined and exported variables.
-  diff_utils::compute_diff<vars_it_type, eq_type>
-    (f->get_variables().begin(), f->get_variables().end(),
-     s->get_variables().begin(), s->get_variables().end(),
-     r->priv_->vars_edit_script_);
-
-  // Compute the diff of function elf symbols not referenced by debug
-  // info.
-  diff_utils::compute_diff<symbols_it_type, eq_type>
-    (f->get_unreferenced_function_symbols().begin(),
-     f->get_unreferenced_function_symbols().end(),
-     s->get_unreferenced_function_symbols().begin(),
-     s->get_unreferenced_function_symbols().end(),
-     r->priv_->unrefed_fn_syms_edit_script_);
-
-  // Compute the diff of variable elf symbols not referenced by debug
-  // info.
-    diff_utils::compute_diff<symbols_it_type, eq_type>
-    (f->get_unreferenced_variable_symbols().begin(),
-     f->get_unreferenced_variable_symbols().end(),
-     s->get_unreferenced_variable_symbols().begin(),
-     s->get_unreferenced_variable_symbols().end(),
-     r->priv_->unrefed_var_syms_edit_script_);
+  if (ctxt->match_decls_by_id())
+    {
+      // Match the functions, variables and symbols of the two corpora
+      // on their ID rather than computing edit scripts between whole
+      // sequences of them.
+      compute_diff_by_id(f->get_functions(),
+			 s->get_functions(),
+			 r->priv_->fns_edit_script_);
+
+      compute_diff_by_id(f->get_variables(),
+			 s->get_variables(),
+			 r->priv_->vars_edit_script_);
+
+      compute_diff_by_id(f->get_unreferenced_function_symbols(),
+			 s->get_unreferenced_function_symbols(),
+			 r->priv_->unrefed_fn_syms_edit_script_);
+
+      compute_diff_by_id(f->get_unreferenced_variable_symbols(),
+			 s->get_unreferenced_variable_symbols(),
+			 r->priv_->unrefed_var_syms_edit_script_);
+    }
+  else
+    {
+      // Compute the diff of publicly defined and exported functions
+      diff_utils::compute_diff<fns_it_type, eq_type>
+	(f->get_functions().begin(), f->get_functions().end(),
+	 s->get_functions().begin(), s->get_functions().end(),
+	 r->priv_->fns_edit_script_);
+
+      // Compute the diff of publicly defined and exported variables.
+      diff_utils::compute_diff<vars_it_type, eq_type>
+	(f->get_variables().begin(), f->get_variables().end(),
+	 s->get_variables().begin(), s->get_variables().end(),
+	 r->priv_->vars_edit_script_);
+
+      // Compute the diff of function elf symbols not referenced by debug
+      // info.
+      diff_utils::compute_diff<symbols_it_type, eq_type>
+	(f->get_unreferenced_function_symbols().begin(),
+	 f->get_unreferenced_function_symbols().end(),
+	 s->get_unreferenced_function_symbols().begin(),
+	 s->get_unreferenced_function_symbols().end(),
+	 r->priv_->unrefed_fn_syms_edit_script_);
+
+      // Compute the diff of variable elf symbols not referenced by debug
+      // info.
+      diff_utils::compute_diff<symbols_it_type, eq_type>
+	(f->get_unreferenced_variable_symbols().begin(),
+	 f->get_unreferenced_variable_symbols().end(),
+	 s->get_unreferenced_variable_symbols().begin(),
+	 s->get_unreferenced_variable_symbols().end(),
+	 r->priv_->unrefed_var_syms_edit_script_);
+    }
 
     if (ctxt->show_unreachable_types())
       // Compute the diff of types not reachable from public functions
@@ -11519,6 +11855,175 @@ struct category_propagation_visitor : public diff_node_visitor
   }
 };// end struct category_propagation_visitor
 
+/// A visitor that applies a set of categorization filters to the
+/// nodes of a diff tree and propagates the categories of the nodes up
+/// to their parent nodes, in a single traversal of the tree.
+///
+/// As the categories of the children nodes are propagated to their
+/// parent once they have all been visited, this is equivalent to
+/// applying each filter in turn with filtering::apply_filter and
+/// invoking propagate_categories after each of them, but it walks the
+/// diff tree only once.
+///
+/// When a filter returns false from its visit member function, a
+/// traversal dedicated to that filter would stop there.  So from then
+/// on, that filter is only invoked on the visit_end of the nodes that
+/// were being traversed at that point, just like diff::traverse does
+/// while unwinding.  The traversal goes on for the other filters and
+/// for the propagation of categories.
+struct filtering_category_propagation_visitor
+  : public category_propagation_visitor
+{
+  const filtering::filters& filters_;
+  // The depth of the node being visited, starting at 1 for the root
+  // of the tree.
+  size_t depth_;
+  // For each filter, whether its traversal has stopped.
+  vector<bool> stopped_;
+  // For each filter whose traversal has stopped, the depth of the
+  // next node whose visit_end it has to see.  Nodes are finished in
+  // post-order, so that is the next node finished at that depth or
+  // above.
+  vector<size_t> unwinding_depth_;
+
+  filtering_category_propagation_visitor(const filtering::filters& filters)
+    : filters_(filters),
+      depth_(0),
+      stopped_(filters.size(), false),
+      unwinding_depth_(filters.size(), 0)
+  {}
+
+  template<typename diff_type>
+  void
+  begin_node(diff_type* d)
+  {
+    ++depth_;
+    for (size_t i = 0; i < filters_.size(); ++i)
+      if (!stopped_[i])
+	filters_[i]->visit_begin(d);
+  }
+
+  template<typename diff_type>
+  bool
+  visit_node(diff_type* d, bool pre)
+  {
+    for (size_t i = 0; i < filters_.size(); ++i)
+      if (!stopped_[i] && !filters_[i]->visit(d, pre))
+	{
+	  stopped_[i] = true;
+	  unwinding_depth_[i] = depth_;
+	}
+    return true;
+  }
+
+  template<typename diff_type>
+  void
+  end_node(diff_type* d)
+  {
+    for (size_t i = 0; i < filters_.size(); ++i)
+      if (!stopped_[i])
+	filters_[i]->visit_end(d);
+      else if (depth_ <= unwinding_depth_[i])
+	{
+	  filters_[i]->visit_end(d);
+	  unwinding_depth_[i] = depth_ - 1;
+	}
+    --depth_;
+  }
+
+  virtual void
+  visit_begin(diff* d)
+  {begin_node(d);}
+
+  virtual void
+  visit_begin(corpus_diff* d)
+  {begin_node(d);}
+
+  virtual bool
+  visit(diff* d, bool pre)
+  {return visit_node(d, pre);}
+
+  virtual bool
+  visit(corpus_diff* d, bool pre)
+  {return visit_node(d, pre);}
+
+  virtual void
+  visit_end(diff* d)
+  {
+    end_node(d);
+    category_propagation_visitor::visit_end(d);
+  }
+
+  virtual void
+  visit_end(corpus_diff* d)
+  {end_node(d);}
+};// end struct filtering_category_propagation_visitor
+
+/// Test if a set of categorization filters can be applied by
+/// apply_filters_and_propagate_categories.
+///
+/// The traversal done by filtering_category_propagation_visitor uses
+/// the default visiting kind, so it can only stand for the traversals
+/// of filters that use that visiting kind too.
+///
+/// @param filters the filters to consider.
+///
+/// @return true iff all the filters of @p filters use the default
+/// visiting kind.
+bool
+filters_can_be_applied_in_one_walk(const filtering::filters& filters)
+{
+  for (filtering::filters::const_iterator i = filters.begin();
+       i != filters.end();
+       ++i)
+    if ((*i)->get_visiting_kind() != DEFAULT_VISITING_KIND)
+      return false;
+  return true;
+}
+
+/// Apply a set of categorization filters to the nodes of a given diff
+/// sub-tree and propagate the categories of the nodes up to their
+/// parent nodes, walking the sub-tree only once.
+///
+/// @param filters the filters to apply.
+///
+/// @param diff_tree the diff sub-tree to walk.
+void
+apply_filters_and_propagate_categories(const filtering::filters& filters,
+				       diff* diff_tree)
+{
+  if (filters.empty())
+    return;
+
+  filtering_category_propagation_visitor v(filters);
+  bool s = diff_tree->context()->visiting_a_node_twice_is_forbidden();
+  diff_tree->context()->forbid_visiting_a_node_twice(true);
+  diff_tree->context()->forget_visited_diffs();
+  diff_tree->traverse(v);
+  diff_tree->context()->forbid_visiting_a_node_twice(s);
+}
+
+/// Apply a set of categorization filters to the nodes of a given
+/// corpus diff tree and propagate the categories of the nodes up to
+/// their parent nodes, walking the tree only once.
+///
+/// @param filters the filters to apply.
+///
+/// @param diff_tree the corpus diff tree to walk.
+void
+apply_filters_and_propagate_categories(const filtering::filters& filters,
+				       corpus_diff* diff_tree)
+{
+  if (filters.empty())
+    return;
+
+  filtering_category_propagation_visitor v(filters);
+  bool s = diff_tree->context()->visiting_a_node_twice_is_forbidden();
+  diff_tree->context()->forbid_visiting_a_node_twice(false);
+  diff_tree->traverse(v);
+  diff_tree->context()->forbid_visiting_a_node_twice(s);
+}
+
 /// Visit all the nodes of a given sub-tree.  For each node that has a
 /// particular category set, propagate that category set up to its
 /// parent nodes.
@@ -11801,7 +12306,7 @@ struct suppression_categorization_visitor : public diff_node_visitor
 void
 apply_suppressions(diff* diff_tree)
 {
-  if (diff_tree && !diff_tree->context()->suppressions().empty())
+  if (diff_tree && !const_suppressions(diff_tree->context()).empty())
     {
       // Apply suppressions to functions and variables that have
       // changed sub-types.
@@ -11833,7 +12338,7 @@ apply_suppressions(diff_sptr diff_tree)
 void
 apply_suppressions(const corpus_diff* diff_tree)
 {
-  if (diff_tree && !diff_tree->context()->suppressions().empty())
+  if (diff_tree && !const_suppressions(diff_tree->context()).empty())
     {
       // First, visit the children trees of changed constructs:
       // changed functions, variables, as well as sub-types of these,
@@ -12384,8 +12889,11 @@ clear_redundancy_categorization(corpus_diff_sptr diff_tree)
 void
 apply_filters(corpus_diff_sptr diff_tree)
 {
-  diff_tree->context()->maybe_apply_filters(diff_tree);
-  propagate_categories(diff_tree);
+  if (diff_tree->context()->diff_filters().empty())
+    propagate_categories(diff_tree);
+  else
+    // This propagates the categories as well.
+    diff_tree->context()->maybe_apply_filters(diff_tree);
 }
 
 /// Test if a diff node represents the difference between a variadic
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2013-2020 Red Hat, Inc.
+
+/// @file
+///
+/// This contains the declaration of the map used by the DWARF reader
+/// to associate things to the offsets of DIEs.
+
+#ifndef __ABG_DIE_OFFSET_MAP_H__
+#define __ABG_DIE_OFFSET_MAP_H__
+
+#include <elfutils/libdw.h>
+#include <stdint.h>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace abigail
+{
+
+namespace dwarf_reader
+{
+
+/// A map which key is the offset of a DIE.
+///
+/// The reader associates millions of DIEs to things like their
+/// parent DIE, their canonical DIE, their names or the IR artifacts
+/// built from them.  A node based hash map would use one heap
+/// allocation per entry for that.  This map rather appends its
+/// entries to a std::deque, which allocates them by big blocks, and
+/// indexes them with a flat array of slots, using open addressing
+/// with linear probing.  DIE offsets are unique and are hashed by
+/// multiplication so that the (mostly increasing) offsets are spread
+/// over the whole array.
+///
+/// Like with std::unordered_map, adding an entry can invalidate
+/// iterators, but never invalidates references or pointers to the
+/// entries already in the map: growing the index doesn't move them.
+/// Iterating over the map visits the entries in the order in which
+/// they were added.
+///
+/// Entries can only be added or modified; they cannot be removed,
+/// except by clearing the whole map.
+///
+/// The interface is the subset of the one of std::unordered_map that
+/// is used by the reader.
+template <typename V>
+class die_offset_map
+{
+public:
+  typedef std::pair<Dwarf_Off, V> value_type;
+  typedef typename std::deque<value_type>::iterator iterator;
+  typedef typename std::deque<value_type>::const_iterator const_iterator;
+
+private:
+  /// A slot of the index.  It holds the key of an entry, to avoid
+  /// touching the entry while probing, and the position of that entry
+  /// in entries_, plus one.  A slot which position is zero is empty.
+  struct slot
+  {
+    Dwarf_Off	key;
+    size_t	pos;
+
+    slot()
+      : key(), pos()
+    {}
+  };
+
+  std::deque<value_type>	entries_;
+  std::vector<slot>		slots_;
+  unsigned			log2_capacity_;
+
+  /// @return the index of the first slot to probe for a given key.
+  size_t
+  bucket_of(Dwarf_Off key) const
+  {
+    // Fibonacci hashing.
+    return static_cast<size_t>((key * UINT64_C(0x9e3779b97f4a7c15))
+			       >> (64 - log2_capacity_));
+  }
+
+  /// @return the index of the slot which holds a given key, or the
+  /// index of the empty slot where that key would go.
+  size_t
+  slot_of(Dwarf_Off key) const
+  {
+    size_t mask = slots_.size() - 1;
+    size_t i = bucket_of(key);
+    while (slots_[i].pos && slots_[i].key != key)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  /// Double the number of slots and re-index the entries.  The
+  /// entries themselves are left in place.
+  void
+  grow()
+  {
+    log2_capacity_ = slots_.empty() ? 6 : log2_capacity_ + 1;
+    std::vector<slot>(static_cast<size_t>(1) << log2_capacity_).swap(slots_);
+    for (size_t i = 0; i < entries_.size(); ++i)
+      {
+	slot& s = slots_[slot_of(entries_[i].first)];
+	s.key = entries_[i].first;
+	s.pos = i + 1;
+      }
+  }
+
+public:
+
+  die_offset_map()
+    : log2_capacity_()
+  {}
+
+  /// @return the number of entries of the map.
+  size_t
+  size() const
+  {return entries_.size();}
+
+  /// @return true iff the map has no entry.
+  bool
+  empty() const
+  {return entries_.empty();}
+
+  iterator
+  begin()
+  {return entries_.begin();}
+
+  iterator
+  end()
+  {return entries_.end();}
+
+  const_iterator
+  begin() const
+  {return entries_.begin();}
+
+  const_iterator
+  end() const
+  {return entries_.end();}
+
+  /// Find the entry of a given DIE offset.
+  ///
+  /// @param key the DIE offset to look for.
+  ///
+  /// @return an iterator to the entry found, or end() if none was
+  /// found.
+  iterator
+  find(Dwarf_Off key)
+  {
+    if (entries_.empty())
+      return end();
+    const slot& s = slots_[slot_of(key)];
+    if (!s.pos)
+      return end();
+    return entries_.begin() + (s.pos - 1);
+  }
+
+  /// Find the entry of a given DIE offset.
+  ///
+  /// @param key the DIE offset to look for.
+  ///
+  /// @return an iterator to the entry found, or end() if none was
+  /// found.
+  const_iterator
+  find(Dwarf_Off key) const
+  {return const_cast<die_offset_map*>(this)->find(key);}
+
+  /// Get the value associated to a given DIE offset, creating a
+  /// default-constructed one if there was none.
+  ///
+  /// The reference returned stays valid until the map is cleared,
+  /// even if other entries are added in the mean time.
+  ///
+  /// @param key the DIE offset to consider.
+  ///
+  /// @return the value associated to @p key.
+  V&
+  operator[](Dwarf_Off key)
+  {
+    // Keep the load factor at 7/8 at most.
+    if ((entries_.size() + 1) * 8 > slots_.size() * 7)
+      grow();
+    slot& s = slots_[slot_of(key)];
+    if (!s.pos)
+      {
+	entries_.push_back(value_type(key, V()));
+	s.key = key;
+	s.pos = entries_.size();
+      }
+    return entries_[s.pos - 1].second;
+  }
+
+  /// Remove all the entries of the map and release its memory.
+  void
+  clear()
+  {
+    std::deque<value_type>().swap(entries_);
+    std::vector<slot>().swap(slots_);
+    log2_capacity_ = 0;
+  }
+}; // end class die_offset_map
+
+} // end namespace dwarf_reader
+
+} // end namespace abigail
+
+#endif // __ABG_DIE_OFFSET_MAP_H__
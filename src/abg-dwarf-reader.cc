@@ -19,12 +19,15 @@
 #include <libgen.h>
 #include <assert.h>
 #include <limits.h>
+#include <pthread.h>
 #include <elfutils/libdwfl.h>
 #include <dwarf.h>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <deque>
+#include <fstream>
 #include <list>
 #include <memory>
 #include <ostream>
@@ -37,16 +40,21 @@
 #include "abg-ir-priv.h"
 #include "abg-suppression-priv.h"
 #include "abg-corpus-priv.h"
+#include "abg-die-offset-map.h"
 #include "abg-elf-helpers.h"
 #include "abg-internal.h"
 
 // <headers defining libabigail's API go under here>
 ABG_BEGIN_EXPORT_DECLARATIONS
 
+#include "abg-config.h"
 #include "abg-dwarf-reader.h"
+#include "abg-hash.h"
+#include "abg-reader.h"
 #include "abg-sptr-utils.h"
 #include "abg-symtab-reader.h"
 #include "abg-tools-utils.h"
+#include "abg-writer.h"
 
 ABG_END_EXPORT_DECLARATIONS
 // </headers defining libabigail's API>
@@ -117,7 +125,7 @@ typedef vector<Dwarf_Off> dwarf_offsets_type;
 
 /// Convenience typedef for a map which key is the offset of a dwarf
 /// die and which value is the corresponding artefact.
-typedef unordered_map<Dwarf_Off, type_or_decl_base_sptr> die_artefact_map_type;
+typedef die_offset_map<type_or_decl_base_sptr> die_artefact_map_type;
 
 /// Convenience typedef for a map which key is the offset of a dwarf
 /// die, (given by dwarf_dieoffset()) and which value is the
@@ -144,7 +152,12 @@ typedef unordered_map<Dwarf_Off, translation_unit_sptr> die_tu_map_type;
 
 /// Convenience typedef for a map which key is the offset of a DIE and
 /// the value is the corresponding qualified name of the DIE.
-typedef unordered_map<Dwarf_Off, interned_string> die_istring_map_type;
+typedef die_offset_map<interned_string> die_istring_map_type;
+
+/// Convenience typedef for a map which key is the offset of a DIE and
+/// the value is the fingerprint of the DIE, as computed by
+/// compute_die_fingerprint().
+typedef die_offset_map<uint64_t> die_fingerprint_map_type;
 
 /// Convenience typedef for a map which is an interned_string and
 /// which value is a vector of offsets.
@@ -182,7 +195,7 @@ typedef stack<scope_decl*> scope_stack_type;
 
 /// Convenience typedef for a map which key is a dwarf offset.  The
 /// value is also a dwarf offset.
-typedef unordered_map<Dwarf_Off, Dwarf_Off> offset_offset_map_type;
+typedef die_offset_map<Dwarf_Off> offset_offset_map_type;
 
 /// Convenience typedef for a map which key is a string and which
 /// value is a vector of smart pointer to a class.
@@ -272,6 +285,81 @@ typedef vector<imported_unit_point> imported_unit_points_type;
 typedef unordered_map<Dwarf_Off, imported_unit_points_type>
 tu_die_imported_unit_points_map_type;
 
+/// The DIE -> parent map and the unit import points of the DIEs of an
+/// alternate debug info file.
+///
+/// Many debug info files can refer to the same alternate debug info
+/// file, e.g, the .dwz file of a package.  These maps only depend on
+/// the content of that file, so they are built only once and then
+/// shared by all the read contexts that use the same alternate debug
+/// info file.  Once built, they are never modified.
+///
+/// See get_shared_alt_die_parent_maps().
+struct alt_die_parent_maps
+{
+  /// The DIE -> parent map.
+  offset_offset_map_type		parent_map;
+  /// The map that associates each unit DIE to its unit import points.
+  tu_die_imported_unit_points_map_type	imported_unit_points;
+  /// Set to true once the two maps above have been built.
+  bool					is_built;
+  /// Serializes the building of the maps.
+  pthread_mutex_t			lock;
+
+  alt_die_parent_maps()
+    : is_built()
+  {pthread_mutex_init(&lock, /*mutex_attr=*/0);}
+
+  ~alt_die_parent_maps()
+  {pthread_mutex_destroy(&lock);}
+}; // end struct alt_die_parent_maps
+
+/// Convenience typedef for a shared pointer to @ref
+/// alt_die_parent_maps.
+typedef shared_ptr<alt_die_parent_maps> alt_die_parent_maps_sptr;
+
+/// Convenience typedef for a map that associates the build-id of an
+/// alternate debug info file to its @ref alt_die_parent_maps.
+typedef unordered_map<string, weak_ptr<alt_die_parent_maps> >
+string_alt_die_parent_maps_map_type;
+
+/// The process-wide set of @ref alt_die_parent_maps, keyed by the
+/// build-id of their alternate debug info file.
+///
+/// This only holds weak references, so the maps of a given alternate
+/// debug info file are released once no read context uses them
+/// anymore.
+static string_alt_die_parent_maps_map_type shared_alt_die_parent_maps;
+
+/// Serializes the accesses to shared_alt_die_parent_maps.
+static pthread_mutex_t shared_alt_die_parent_maps_lock =
+  PTHREAD_MUTEX_INITIALIZER;
+
+/// Get the @ref alt_die_parent_maps of the alternate debug info file
+/// which has a given build-id.
+///
+/// If no read context currently uses the maps of that file, new
+/// (empty) maps are returned.
+///
+/// @param build_id the build-id of the alternate debug info file.
+///
+/// @return the maps.  Note that the caller must build them if their
+/// is_built data member is false, after acquiring their lock.
+static alt_die_parent_maps_sptr
+get_shared_alt_die_parent_maps(const string& build_id)
+{
+  pthread_mutex_lock(&shared_alt_die_parent_maps_lock);
+  weak_ptr<alt_die_parent_maps>& entry = shared_alt_die_parent_maps[build_id];
+  alt_die_parent_maps_sptr result = entry.lock();
+  if (!result)
+    {
+      result.reset(new alt_die_parent_maps);
+      entry = result;
+    }
+  pthread_mutex_unlock(&shared_alt_die_parent_maps_lock);
+  return result;
+}
+
 /// "Less than" operator for instances of @ref imported_unit_point
 /// type.
 ///
@@ -523,19 +611,28 @@ compare_dies(const read_context& ctxt,
 	     const Dwarf_Die *l, const Dwarf_Die *r,
 	     bool update_canonical_dies_on_the_fly);
 
+static uint64_t
+compute_die_fingerprint(const read_context& ctxt, const Dwarf_Die *die);
 
-/// Find the file name of the alternate debug info file.
+
+/// Find the file name and the build-id of the alternate debug info
+/// file.
 ///
 /// @param elf_module the elf module to consider.
 ///
 /// @param out parameter.  Is set to the file name of the alternate
 /// debug info file, iff this function returns true.
 ///
+/// @param alt_build_id out parameter.  Is set to the (binary)
+/// build-id of the alternate debug info file, iff this function
+/// returns true.
+///
 /// @return true iff the location of the alternate debug info file was
 /// found.
 static bool
 find_alt_debug_info_link(Dwfl_Module *elf_module,
-			 string &alt_file_name)
+			 string &alt_file_name,
+			 string &alt_build_id)
 {
   GElf_Addr bias = 0;
   Dwarf *dwarf = dwfl_module_getdwarf(elf_module, &bias);
@@ -580,12 +677,30 @@ find_alt_debug_info_link(Dwfl_Module *elf_module,
 	return false;
 
       alt_file_name = alt_name;
+      alt_build_id.assign(buildid, buildid_len);
       return true;
     }
 
   return false;
 }
 
+/// Find the file name of the alternate debug info file.
+///
+/// @param elf_module the elf module to consider.
+///
+/// @param out parameter.  Is set to the file name of the alternate
+/// debug info file, iff this function returns true.
+///
+/// @return true iff the location of the alternate debug info file was
+/// found.
+static bool
+find_alt_debug_info_link(Dwfl_Module *elf_module,
+			 string &alt_file_name)
+{
+  string alt_build_id;
+  return find_alt_debug_info_link(elf_module, alt_file_name, alt_build_id);
+}
+
 /// Find alternate debuginfo file of a given "link" under a set of
 /// root directories.
 ///
@@ -1923,13 +2038,15 @@ public:
     bool		load_all_types;
     bool		show_stats;
     bool		do_log;
+    bool		exported_interfaces_only;
 
     options_type()
       : env(),
 	load_in_linux_kernel_mode(),
 	load_all_types(),
 	show_stats(),
-	do_log()
+	do_log(),
+	exported_interfaces_only()
     {}
   };// read_context::options_type
 
@@ -2088,6 +2205,16 @@ public:
   /// the offset of a decl DIE to the offset of its canonical DIE.
   mutable die_source_dependant_container_set<offset_offset_map_type>
   canonical_decl_die_offsets_;
+  /// A set of maps (one per kind of die source) that associates the
+  /// offset of a type DIE to its fingerprint.
+  mutable die_source_dependant_container_set<die_fingerprint_map_type>
+  type_die_fingerprint_maps_;
+  /// The number of structural comparisons of type DIEs that were
+  /// performed while looking for canonical DIEs.
+  mutable size_t		num_type_die_comparisons_;
+  /// The number of structural comparisons of type DIEs that were
+  /// avoided because the fingerprints of the DIEs were different.
+  mutable size_t		num_type_die_comparisons_avoided_;
   /// A map that associates a function type representations to
   /// function types, inside a translation unit.
   mutable istring_fn_type_map_type per_tu_repr_to_fn_type_maps_;
@@ -2115,13 +2242,12 @@ public:
   // A map that associates each tu die to a vector of unit import
   // points, in the main debug info
   tu_die_imported_unit_points_map_type tu_die_imported_unit_points_map_;
-  // A map that associates each tu die to a vector of unit import
-  // points, in the alternate debug info
-  tu_die_imported_unit_points_map_type alt_tu_die_imported_unit_points_map_;
   tu_die_imported_unit_points_map_type type_units_tu_die_imported_unit_points_map_;
-  // A DIE -> parent map for DIEs coming from the alternate debug info
-  // file.
-  offset_offset_map_type	alternate_die_parent_map_;
+  // The DIE -> parent map and the map that associates each tu die to
+  // a vector of unit import points, for DIEs coming from the
+  // alternate debug info file.  These can be shared with other read
+  // contexts.
+  alt_die_parent_maps_sptr	alt_die_parent_maps_;
   offset_offset_map_type	type_section_die_parent_map_;
   list<var_decl_sptr>		var_decls_to_add_;
   vector<string>		dt_needed_;
@@ -2131,6 +2257,7 @@ public:
   options_type			options_;
   bool				drop_undefined_syms_;
   bool				merge_translation_units_;
+  string			corpus_cache_dir_;
   read_context();
 
 private:
@@ -2237,6 +2364,9 @@ public:
     type_die_artefact_maps_.clear();
     canonical_type_die_offsets_.clear();
     canonical_decl_die_offsets_.clear();
+    type_die_fingerprint_maps_.clear();
+    num_type_die_comparisons_ = 0;
+    num_type_die_comparisons_avoided_ = 0;
     die_wip_classes_map_.clear();
     alternate_die_wip_classes_map_.clear();
     type_unit_die_wip_classes_map_.clear();
@@ -2255,9 +2385,8 @@ public:
     cur_tu_.reset();
     primary_die_parent_map_.clear();
     tu_die_imported_unit_points_map_.clear();
-    alt_tu_die_imported_unit_points_map_.clear();
     type_units_tu_die_imported_unit_points_map_.clear();
-    alternate_die_parent_map_.clear();
+    alt_die_parent_maps_.reset(new alt_die_parent_maps);
     type_section_die_parent_map_.clear();
     var_decls_to_add_.clear();
     dt_needed_.clear();
@@ -2275,6 +2404,7 @@ public:
     options_.load_all_types = load_all_types;
     drop_undefined_syms_ = false;
     merge_translation_units_ = false;
+    corpus_cache_dir_.clear();
     load_in_linux_kernel_mode(linux_kernel_mode);
   }
 
@@ -2370,6 +2500,22 @@ public:
   merge_translation_units(bool f)
   {merge_translation_units_ = f;}
 
+  /// Getter for the directory of the on-disk cache of corpora.
+  ///
+  /// @return the path to the directory of the cache, or an empty
+  /// string if the cache is not used.
+  const string&
+  corpus_cache_dir() const
+  {return corpus_cache_dir_;}
+
+  /// Setter for the directory of the on-disk cache of corpora.
+  ///
+  /// @param d the path to the directory of the cache.  If it's empty,
+  /// the cache is not used.
+  void
+  corpus_cache_dir(const string& d)
+  {corpus_cache_dir_ = d;}
+
   /// Getter for the flag that tells us if we are merging translation
   /// units.
   ///
@@ -2837,8 +2983,15 @@ public:
       {
 	cur_die_offset = *o;
 	get_die_from_offset(source, cur_die_offset, &potential_canonical_die);
-	if (compare_dies(*this, &die, &potential_canonical_die,
-			 /*update_canonical_dies_on_the_fly=*/false))
+	// Skipping compare_dies() when the fingerprints differ is
+	// only possible here because it doesn't update the canonical
+	// DIEs of sub-DIEs on the fly.  Elsewhere, compare_dies()
+	// must be invoked even on DIEs that are known to be different,
+	// for the sake of these updates.
+	if ((!die_as_type
+	     || type_die_fingerprints_match(&die, &potential_canonical_die))
+	    && compare_dies(*this, &die, &potential_canonical_die,
+			    /*update_canonical_dies_on_the_fly=*/false))
 	  {
 	    canonical_die_offset = cur_die_offset;
 	    set_canonical_die_offset(canonical_dies, die_offset,
@@ -3083,6 +3236,53 @@ public:
     return false;
   }
 
+  /// Get the fingerprint of a type DIE.
+  ///
+  /// The fingerprint is computed by compute_die_fingerprint() the
+  /// first time it's requested, and cached afterwards.
+  ///
+  /// @param die the type DIE to consider.
+  ///
+  /// @return the fingerprint of @p die.
+  uint64_t
+  get_type_die_fingerprint(const Dwarf_Die* die) const
+  {
+    die_fingerprint_map_type& m =
+      type_die_fingerprint_maps_.get_container(*this, die);
+    Dwarf_Off offset = dwarf_dieoffset(const_cast<Dwarf_Die*>(die));
+
+    die_fingerprint_map_type::const_iterator i = m.find(offset);
+    if (i != m.end())
+      return i->second;
+
+    uint64_t fingerprint = compute_die_fingerprint(*this, die);
+    m[offset] = fingerprint;
+    return fingerprint;
+  }
+
+  /// Test if two type DIEs have the same fingerprint, that is, if
+  /// there is a chance that compare_dies() finds them equal.
+  ///
+  /// This also updates the statistics about the number of DIE
+  /// comparisons that are performed and avoided.
+  ///
+  /// @param l the first type DIE to consider.
+  ///
+  /// @param r the second type DIE to consider.
+  ///
+  /// @return false iff @p l and @p r are known to be different.
+  bool
+  type_die_fingerprints_match(const Dwarf_Die* l, const Dwarf_Die* r) const
+  {
+    if (get_type_die_fingerprint(l) != get_type_die_fingerprint(r))
+      {
+	++num_type_die_comparisons_avoided_;
+	return false;
+      }
+    ++num_type_die_comparisons_;
+    return true;
+  }
+
   /// Get the source of the DIE.
   ///
   /// The function returns an enumerator value saying if the DIE comes
@@ -4776,8 +4976,14 @@ public:
 	cn_timer.start();
       }
 
-    if (!types_to_canonicalize(source).empty()
-	|| !extra_types_to_canonicalize().empty())
+    // The types that are not tied to any DIE are canonicalized
+    // along with the types of the primary debug info, once.  The
+    // passes for the other DIE sources would just find them already
+    // canonicalized.
+    bool do_extra_types = (source == PRIMARY_DEBUG_INFO_DIE_SOURCE
+			   && !extra_types_to_canonicalize().empty());
+
+    if (!types_to_canonicalize(source).empty() || do_extra_types)
       {
 	tools_utils::timer single_type_cn_timer;
 	size_t total = types_to_canonicalize(source).size();
@@ -4810,7 +5016,7 @@ public:
 
 	// Now canonicalize types that were created but not tied to
 	// any DIE.
-	if (!extra_types_to_canonicalize().empty())
+	if (do_extra_types)
 	  {
 	    tools_utils::timer single_type_cn_timer;
 	    size_t total = extra_types_to_canonicalize().size();
@@ -4936,6 +5142,22 @@ public:
         if (total)
           cerr << " (" << num_missed * 100 / total << "%)";
         cerr << "\n";
+
+	total = num_type_die_comparisons_ + num_type_die_comparisons_avoided_;
+	cerr << "    # type DIE comparisons avoided by fingerprints: "
+	     << num_type_die_comparisons_avoided_;
+	if (total)
+	  cerr << " ("
+	       << num_type_die_comparisons_avoided_ * 100 / total
+	       << "%)";
+	cerr << "\n";
+
+	size_t num_lookups = 0, num_hits = 0;
+	env()->get_type_comparison_cache_stats(num_lookups, num_hits);
+	cerr << "    # type comparisons found in cache: " << num_hits;
+	if (num_lookups)
+	  cerr << " (" << num_hits * 100 / num_lookups << "%)";
+	cerr << "\n";
       }
 
   }
@@ -4972,7 +5194,7 @@ public:
       case PRIMARY_DEBUG_INFO_DIE_SOURCE:
 	break;
       case ALT_DEBUG_INFO_DIE_SOURCE:
-	return alt_tu_die_imported_unit_points_map_;
+	return alt_die_parent_maps_->imported_unit_points;
       case TYPE_UNIT_DIE_SOURCE:
 	return type_units_tu_die_imported_unit_points_map_;
       case NO_DEBUG_INFO_DIE_SOURCE:
@@ -5129,7 +5351,7 @@ public:
       case PRIMARY_DEBUG_INFO_DIE_SOURCE:
 	break;
       case ALT_DEBUG_INFO_DIE_SOURCE:
-	return alternate_die_parent_map_;
+	return alt_die_parent_maps_->parent_map;
       case TYPE_UNIT_DIE_SOURCE:
 	return type_section_die_parent_map();
       case NO_DEBUG_INFO_DIE_SOURCE:
@@ -5855,6 +6077,28 @@ public:
   do_log(bool f)
   {options_.do_log = f;}
 
+  /// Getter of the "exported_interfaces_only" flag.
+  ///
+  /// This flag tells if the IR should be built only for the functions
+  /// and variables that have an exported ELF symbol, and for the
+  /// types reachable from them.
+  ///
+  /// @return the "exported_interfaces_only" flag.
+  bool
+  exported_interfaces_only() const
+  {return options_.exported_interfaces_only;}
+
+  /// Setter of the "exported_interfaces_only" flag.
+  ///
+  /// This flag tells if the IR should be built only for the functions
+  /// and variables that have an exported ELF symbol, and for the
+  /// types reachable from them.
+  ///
+  /// @param f the new value of the flag.
+  void
+  exported_interfaces_only(bool f)
+  {options_.exported_interfaces_only = f;}
+
   /// If a given function decl is suitable for the set of exported
   /// functions of the current corpus, this function adds it to that
   /// set.
@@ -6034,24 +6278,37 @@ public:
       return;
 
     // Build the DIE -> parent relation for DIEs coming from the
-    // .debug_info section in the alternate debug info file.
+    // .debug_info section in the alternate debug info file.  If
+    // another read context has already built it for the same
+    // alternate debug info file, just re-use it.
     die_source source = ALT_DEBUG_INFO_DIE_SOURCE;
-    for (Dwarf_Off offset = 0, next_offset = 0;
-	 (dwarf_next_unit(alt_dwarf(), offset, &next_offset, &header_size,
-			  NULL, NULL, &address_size, NULL, NULL, NULL) == 0);
-	 offset = next_offset)
+    string alt_build_id, alt_file_name;
+    if (alt_dwarf()
+	&& find_alt_debug_info_link(elf_module(), alt_file_name, alt_build_id))
+      alt_die_parent_maps_ = get_shared_alt_die_parent_maps(alt_build_id);
+
+    pthread_mutex_lock(&alt_die_parent_maps_->lock);
+    if (!alt_die_parent_maps_->is_built)
       {
-	Dwarf_Off die_offset = offset + header_size;
-	Dwarf_Die cu;
-	if (!dwarf_offdie(alt_dwarf(), die_offset, &cu))
-	  continue;
-	cur_tu_die(&cu);
+	for (Dwarf_Off offset = 0, next_offset = 0;
+	     (dwarf_next_unit(alt_dwarf(), offset, &next_offset, &header_size,
+			      NULL, NULL, &address_size, NULL, NULL, NULL) == 0);
+	     offset = next_offset)
+	  {
+	    Dwarf_Off die_offset = offset + header_size;
+	    Dwarf_Die cu;
+	    if (!dwarf_offdie(alt_dwarf(), die_offset, &cu))
+	      continue;
+	    cur_tu_die(&cu);
 
-	imported_unit_points_type& imported_units =
-	  tu_die_imported_unit_points_map(source)[die_offset] =
-	  imported_unit_points_type();
-	build_die_parent_relations_under(&cu, source, imported_units);
+	    imported_unit_points_type& imported_units =
+	      tu_die_imported_unit_points_map(source)[die_offset] =
+	      imported_unit_points_type();
+	    build_die_parent_relations_under(&cu, source, imported_units);
+	  }
+	alt_die_parent_maps_->is_built = true;
       }
+    pthread_mutex_unlock(&alt_die_parent_maps_->lock);
 
     // Build the DIE -> parent relation for DIEs coming from the
     // .debug_info section of the main debug info file.
@@ -6267,6 +6524,40 @@ void
 set_do_log(read_context& ctxt, bool f)
 {ctxt.do_log(f);}
 
+/// Setter of the "exported_interfaces_only" flag.
+///
+/// If this flag is set, the IR is built only for the functions and
+/// variables which ELF symbols are exported, and for the types that
+/// are reachable from them.  The DIEs of the other functions and
+/// variables are not looked at beyond their address.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param f the new value of the flag.
+void
+set_exported_interfaces_only(read_context& ctxt, bool f)
+{ctxt.exported_interfaces_only(f);}
+
+/// Setter of the directory of the on-disk cache of corpora.
+///
+/// When this directory is set, read_corpus_from_elf() looks for the
+/// corpus of the binary in the cache before reading its debug info.
+/// If it's not there, the corpus read from the debug info is stored
+/// in the cache.  Corpora are keyed by the build-id of the binary
+/// and of its alternate debug info file, the version of the library,
+/// the options of the read context and its suppression
+/// specifications.
+///
+/// By default, no cache is used.
+///
+/// @param ctxt the DWARF reading context to consider.
+///
+/// @param dir the path to the directory of the cache.  If it's empty,
+/// the cache is not used.
+void
+set_corpus_cache_directory(read_context& ctxt, const string& dir)
+{ctxt.corpus_cache_dir(dir);}
+
 /// Test if a given DIE is anonymous
 ///
 /// @param die the DIE to consider.
@@ -6738,6 +7029,41 @@ die_is_public_decl(Dwarf_Die* die)
   return is_public;
 }
 
+/// Test if a DIE that is a child of a translation unit or of a
+/// namespace should be skipped because the reader was asked to only
+/// build the IR of exported interfaces.
+///
+/// In that mode, the walk of the DIE tree is driven by the exported
+/// ELF symbols: the DIE of a function or a variable is considered
+/// only if its address is the one of an exported symbol.  The types
+/// and declarations that DIE depends on are then built on demand by
+/// build_ir_node_from_die.
+///
+/// @param ctxt the read context to use.
+///
+/// @param die the DIE to consider.
+///
+/// @return true iff @p die should not be turned into an IR node.
+static bool
+die_is_not_an_exported_interface(const read_context& ctxt, Dwarf_Die* die)
+{
+  if (!ctxt.exported_interfaces_only())
+    return false;
+
+  Dwarf_Addr address = 0;
+  switch (dwarf_tag(die))
+    {
+    case DW_TAG_subprogram:
+      return (!ctxt.get_function_address(die, address)
+	      || !ctxt.function_symbol_is_exported(address));
+    case DW_TAG_variable:
+      return (!ctxt.get_variable_address(die, address)
+	      || !ctxt.variable_symbol_is_exported(address));
+    default:
+      return false;
+    }
+}
+
 /// Test whether a given DIE represents a declaration-only DIE.
 ///
 /// That is, if the DIE has the DW_AT_declaration flag set.
@@ -10025,6 +10351,113 @@ fn_die_equal_by_linkage_name(const read_context &ctxt,
 	  && llinkage_name == rlinkage_name);
 }
 
+/// Compute the fingerprint of a type DIE.
+///
+/// The fingerprint is a hash of the properties of the DIE that
+/// compare_dies() always compares when it's invoked on two DIEs that
+/// don't have a canonical DIE yet.  So if the fingerprints of two
+/// such DIEs are different, compare_dies() would find them different
+/// and there is no need to invoke it.
+///
+/// Note that the fingerprint doesn't contain anything about the
+/// types referenced by the DIE.  This is because compare_dies()
+/// doesn't always compare them: it considers that typedefs, pointers
+/// or qualified types of the same name defined in the same
+/// translation unit are equal, it considers aggregates that are
+/// already being compared (i.e, that are part of a cycle) as equal,
+/// and it doesn't compare the types of data members deeper than a few
+/// levels.  For the same reason, the fingerprint doesn't contain the
+/// names of data members, as compare_dies() ignores names that are
+/// present in only one of the two DIEs compared.
+///
+/// @param ctxt the read context to use.
+///
+/// @param die the DIE to compute the fingerprint for.
+///
+/// @return the fingerprint of @p die.
+static uint64_t
+compute_die_fingerprint(const read_context& ctxt, const Dwarf_Die *die)
+{
+  int tag = dwarf_tag(const_cast<Dwarf_Die*>(die));
+  uint64_t result = tag, size = 0;
+
+  switch (tag)
+    {
+    case DW_TAG_string_type:
+      // compare_dies considers that two different DW_TAG_string_type
+      // DIEs are always different.
+      result = hashing::combine_hashes
+	(result, dwarf_dieoffset(const_cast<Dwarf_Die*>(die)));
+      break;
+
+    case DW_TAG_base_type:
+    case DW_TAG_typedef:
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_reference_type:
+    case DW_TAG_const_type:
+    case DW_TAG_volatile_type:
+    case DW_TAG_restrict_type:
+      die_size_in_bits(die, size);
+      result = hashing::combine_hashes(result, size);
+      break;
+
+    case DW_TAG_enumeration_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_union_type:
+      {
+	die_size_in_bits(die, size);
+	result = hashing::combine_hashes(result, size);
+
+	// Hash the tags of the children, and the values of the
+	// enumerators or the offsets of the data members.
+	Dwarf_Die child;
+	if (dwarf_child(const_cast<Dwarf_Die*>(die), &child) == 0)
+	  do
+	    {
+	      int child_tag = dwarf_tag(&child);
+	      result = hashing::combine_hashes(result, child_tag);
+	      if (tag == DW_TAG_enumeration_type
+		  && child_tag == DW_TAG_enumerator)
+		{
+		  uint64_t value = 0;
+		  die_unsigned_constant_attribute(&child, DW_AT_const_value,
+						  value);
+		  result = hashing::combine_hashes(result, value);
+		}
+	      else if (tag != DW_TAG_enumeration_type
+		       && child_tag == DW_TAG_member)
+		{
+		  int64_t offset_in_bits = 0;
+		  die_member_offset(ctxt, &child, offset_in_bits);
+		  result = hashing::combine_hashes(result, offset_in_bits);
+		}
+	    }
+	  while (dwarf_siblingof(&child, &child) == 0);
+      }
+      break;
+
+    case DW_TAG_array_type:
+      {
+	// Only the number of children and the position of the
+	// subranges are always compared.
+	Dwarf_Die child;
+	if (dwarf_child(const_cast<Dwarf_Die*>(die), &child) == 0)
+	  do
+	    result =
+	      hashing::combine_hashes(result,
+				      dwarf_tag(&child) == DW_TAG_subrange_type);
+	  while (dwarf_siblingof(&child, &child) == 0);
+      }
+      break;
+
+    default:
+      break;
+    }
+
+  return result;
+}
+
 /// Compare two DIEs emitted by a C compiler.
 ///
 /// @param ctxt the read context used to load the DWARF information.
@@ -11323,9 +11756,10 @@ build_translation_unit_and_add_to_ir(read_context&	ctxt,
   result->set_is_constructed(false);
 
   do
-    build_ir_node_from_die(ctxt, &child,
-			   die_is_public_decl(&child),
-			   dwarf_dieoffset(&child));
+    if (!die_is_not_an_exported_interface(ctxt, &child))
+      build_ir_node_from_die(ctxt, &child,
+			     die_is_public_decl(&child),
+			     dwarf_dieoffset(&child));
   while (dwarf_siblingof(&child, &child) == 0);
 
   if (!ctxt.var_decls_to_re_add_to_tree().empty())
@@ -11440,9 +11874,10 @@ build_namespace_decl_and_add_to_ir(read_context&	ctxt,
 
   ctxt.scope_stack().push(result.get());
   do
-    build_ir_node_from_die(ctxt, &child,
-			   /*called_from_public_decl=*/false,
-			   where_offset);
+    if (!die_is_not_an_exported_interface(ctxt, &child))
+      build_ir_node_from_die(ctxt, &child,
+			     /*called_from_public_decl=*/false,
+			     where_offset);
   while (dwarf_siblingof(&child, &child) == 0);
   ctxt.scope_stack().pop();
 
@@ -15565,10 +16000,266 @@ set_read_context_corpus_group(read_context& ctxt,
   ctxt.cur_corpus_group_ = group;
 }
 
+/// Hash the properties of a set of suppression specifications that
+/// can drop artifacts from the IR.
+///
+/// @param supprs the suppression specifications to consider.
+///
+/// @return the hash value of @p supprs.
+static uint32_t
+hash_suppressions_for_corpus_cache(const suppr::suppressions_type& supprs)
+{
+  std::ostringstream o;
+  for (suppr::suppressions_type::const_iterator i = supprs.begin();
+       i != supprs.end();
+       ++i)
+    {
+      const suppr::suppression_base& s = **i;
+      o << s.get_file_name_regex_str() << '\0'
+	<< s.get_file_name_not_regex_str() << '\0'
+	<< s.get_soname_regex_str() << '\0'
+	<< s.get_soname_not_regex_str() << '\0';
+
+      if (suppr::type_suppression_sptr t = suppr::is_type_suppression(*i))
+	{
+	  o << "type\0"
+	    << t->get_type_name() << '\0'
+	    << t->get_type_name_regex_str() << '\0'
+	    << t->get_type_name_not_regex_str() << '\0'
+	    << t->get_consider_type_kind() << t->get_type_kind() << '\0'
+	    << t->get_consider_reach_kind() << t->get_reach_kind() << '\0'
+	    << t->get_source_location_to_keep_regex_str() << '\0';
+	  // The locations to keep are not ordered.
+	  vector<string> locations(t->get_source_locations_to_keep().begin(),
+				   t->get_source_locations_to_keep().end());
+	  std::sort(locations.begin(), locations.end());
+	  for (vector<string>::const_iterator l = locations.begin();
+	       l != locations.end();
+	       ++l)
+	    o << *l << '\0';
+	}
+      else if (suppr::function_suppression_sptr f =
+	       suppr::is_function_suppression(*i))
+	{
+	  o << "function\0"
+	    << f->get_change_kind() << '\0'
+	    << f->get_name() << '\0'
+	    << f->get_name_regex_str() << '\0'
+	    << f->get_name_not_regex_str() << '\0'
+	    << f->get_return_type_name() << '\0'
+	    << f->get_return_type_regex_str() << '\0'
+	    << f->get_symbol_name() << '\0'
+	    << f->get_symbol_name_regex_str() << '\0'
+	    << f->get_symbol_name_not_regex_str() << '\0'
+	    << f->get_symbol_version() << '\0'
+	    << f->get_symbol_version_regex_str() << '\0'
+	    << f->get_allow_other_aliases() << '\0';
+	  for (suppr::function_suppression::parameter_specs_type::const_iterator
+		 p = f->get_parameter_specs().begin();
+	       p != f->get_parameter_specs().end();
+	       ++p)
+	    o << (*p)->get_index() << '\0'
+	      << (*p)->get_parameter_type_name() << '\0'
+	      << (*p)->get_parameter_type_name_regex_str() << '\0';
+	}
+      else if (suppr::variable_suppression_sptr v =
+	       suppr::is_variable_suppression(*i))
+	o << "variable\0"
+	  << v->get_change_kind() << '\0'
+	  << v->get_name() << '\0'
+	  << v->get_name_regex_str() << '\0'
+	  << v->get_name_not_regex_str() << '\0'
+	  << v->get_symbol_name() << '\0'
+	  << v->get_symbol_name_regex_str() << '\0'
+	  << v->get_symbol_name_not_regex_str() << '\0'
+	  << v->get_symbol_version() << '\0'
+	  << v->get_symbol_version_regex_str() << '\0'
+	  << v->get_type_name() << '\0'
+	  << v->get_type_name_regex_str() << '\0';
+      else
+	o << "other\0";
+    }
+  return hashing::fnv_hash(o.str());
+}
+
+/// Compute the path of the file holding the cached corpus of the
+/// binary being read.
+///
+/// The name of the file is made of the build-id of the binary, the
+/// build-id of its alternate debug info file if it has one, the
+/// version of the library, the options of the read context that
+/// change the resulting corpus and a hash of the suppression
+/// specifications of the read context.
+///
+/// @param ctxt the read context to consider.
+///
+/// @return the path to the cache file, or an empty string if the
+/// corpus of the binary cannot be cached.
+static string
+get_corpus_cache_file_path(const read_context& ctxt)
+{
+  // The corpora of a group share types with the main corpus of the
+  // group.  These corpora are not cached.
+  if (ctxt.corpus_cache_dir().empty()
+      || ctxt.has_corpus_group()
+      || !ctxt.elf_module())
+    return "";
+
+  const unsigned char* build_id = 0;
+  GElf_Addr vaddr = 0;
+  int build_id_len = dwfl_module_build_id(ctxt.elf_module(),
+					  &build_id, &vaddr);
+  if (build_id_len <= 0)
+    return "";
+
+  std::ostringstream o;
+  o << ctxt.corpus_cache_dir() << "/" << std::hex;
+  for (int i = 0; i < build_id_len; ++i)
+    o << (build_id[i] >> 4) << (build_id[i] & 0xf);
+
+  // The types described in the alternate debug info file are part of
+  // the corpus too.
+  string alt_file_name, alt_build_id;
+  if (ctxt.alt_dwarf()
+      && find_alt_debug_info_link(ctxt.elf_module(),
+				  alt_file_name, alt_build_id))
+    {
+      o << "-";
+      for (string::const_iterator i = alt_build_id.begin();
+	   i != alt_build_id.end();
+	   ++i)
+	{
+	  unsigned char c = *i;
+	  o << (c >> 4) << (c & 0xf);
+	}
+    }
+  o << std::dec;
+
+  string major, minor, revision, suffix;
+  abigail_get_library_version(major, minor, revision, suffix);
+  o << "-" << major << "." << minor << "." << revision;
+
+  o << "-"
+    << ctxt.load_all_types()
+    << (ctxt.load_in_linux_kernel_mode()
+	&& is_linux_kernel(ctxt.elf_handle()))
+    << ctxt.exported_interfaces_only()
+    << ctxt.drop_undefined_syms()
+    << ctxt.merge_translation_units();
+
+  if (!ctxt.get_suppressions().empty())
+    o << "-" << std::hex
+      << hash_suppressions_for_corpus_cache(ctxt.get_suppressions())
+      << std::dec;
+
+  o << ".abb";
+
+  return o.str();
+}
+
+/// Load the corpus of the binary being read from the on-disk cache
+/// of corpora.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param path the path to the cache file, as returned by
+/// get_corpus_cache_file_path().
+///
+/// @return the corpus loaded from the cache, or nil if it's not in
+/// the cache.
+static corpus_sptr
+read_corpus_from_cache(read_context& ctxt, const string& path)
+{
+  corpus_sptr corp;
+  if (!tools_utils::file_exists(path)
+      || (tools_utils::guess_file_type(path)
+	  != tools_utils::FILE_TYPE_BINARY_CORPUS))
+    return corp;
+
+  corp = xml_reader::read_corpus_from_native_binary_file(path, ctxt.env());
+  if (!corp)
+    return corp;
+
+  // The cached corpus might have been read from a binary at another
+  // path.
+  corp->set_path(ctxt.elf_path());
+  if (is_linux_kernel(ctxt.elf_handle()))
+    corp->set_origin(corpus::LINUX_KERNEL_BINARY_ORIGIN);
+  else
+    corp->set_origin(corpus::DWARF_ORIGIN);
+
+  if (ctxt.do_log())
+    cerr << "loaded corpus of " << ctxt.elf_path()
+	 << " from " << path << "\n";
+
+  return corp;
+}
+
+/// Store the corpus of the binary being read into the on-disk cache
+/// of corpora.
+///
+/// The corpus is stored in the native binary corpus format, which is
+/// faster to load than abixml.  It is first written into a temporary
+/// file that is then renamed, so that concurrent readers of the cache
+/// never see a partially written corpus.  The temporary file is
+/// created by mkstemp so that the threads and processes that store
+/// the same corpus at the same time never write into the same file.
+///
+/// @param ctxt the read context to consider.
+///
+/// @param corp the corpus to store.
+///
+/// @param path the path to the cache file, as returned by
+/// get_corpus_cache_file_path().
+static void
+write_corpus_to_cache(const read_context& ctxt,
+		      const corpus_sptr& corp,
+		      const string& path)
+{
+  if (!corp || !tools_utils::ensure_dir_path_created(ctxt.corpus_cache_dir()))
+    return;
+
+  string tmp_path_template = path + ".tmp.XXXXXX";
+  vector<char> tmp_path(tmp_path_template.begin(), tmp_path_template.end());
+  tmp_path.push_back('\0');
+  int fd = mkstemp(&tmp_path[0]);
+  if (fd == -1)
+    return;
+  // mkstemp creates the file readable by its owner only; let the
+  // cache be shared like the files created by the other tools.
+  fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  close(fd);
+
+  {
+    std::ofstream of(&tmp_path[0], std::ios_base::trunc);
+    if (!of.is_open())
+      {
+	unlink(&tmp_path[0]);
+	return;
+      }
+    xml_writer::write_context_sptr wctxt =
+      xml_writer::create_write_context(corp->get_environment(), of);
+    xml_writer::set_binary_output(*wctxt, true);
+    if (!xml_writer::write_corpus(*wctxt, corp, /*indent=*/0) || !of.good())
+      {
+	of.close();
+	unlink(&tmp_path[0]);
+	return;
+      }
+  }
+
+  if (rename(&tmp_path[0], path.c_str()))
+    unlink(&tmp_path[0]);
+}
+
 /// Read all @ref abigail::translation_unit possible from the debug info
 /// accessible from an elf file, stuff them into a libabigail ABI
 /// Corpus and return it.
 ///
+/// If an on-disk cache of corpora is set (see
+/// set_corpus_cache_directory()), the corpus is looked up in there
+/// first, and stored in there after it's been read.
+///
 /// @param ctxt the context to use for reading the elf file.
 ///
 /// @param resulting_corp a pointer to the resulting abigail::corpus.
@@ -15603,10 +16294,24 @@ read_corpus_from_elf(read_context& ctxt, status& status)
     // ... then we cannot handle the binary.
     return corpus_sptr();
 
+  string cache_path;
+  if (!(status & STATUS_DEBUG_INFO_NOT_FOUND))
+    cache_path = get_corpus_cache_file_path(ctxt);
+
+  if (!cache_path.empty())
+    if (corpus_sptr corp = read_corpus_from_cache(ctxt, cache_path))
+      {
+	status |= STATUS_OK;
+	return corp;
+      }
+
   // Read the variable and function descriptions from the debug info
   // we have, through the dwfl handle.
   corpus_sptr corp = read_debug_info_into_corpus(ctxt);
 
+  if (!cache_path.empty())
+    write_corpus_to_cache(ctxt, corp, cache_path);
+
   status |= STATUS_OK;
 
   return corp;
@@ -10,14 +10,18 @@
 /// Definitions for the Internal Representation artifacts of libabigail.
 
 #include <cxxabi.h>
+#include <pthread.h>
+#include <cstring>
 #include <algorithm>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <sstream>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -122,35 +126,229 @@ using std::unordered_map;
 using std::dynamic_pointer_cast;
 using std::static_pointer_cast;
 
-/// Convenience typedef for a map of string -> string*.
-typedef unordered_map<string, string*> pool_map_type;
+/// Hash a string of characters for the purpose of the @ref
+/// interned_string_pool.
+///
+/// This is the FNV-1a hash function.  It works directly on the
+/// characters so that looking up a C string in the pool doesn't
+/// require building a temporary std::string first.
+///
+/// @param s the characters to hash.
+///
+/// @param len the number of characters of @p s to hash.
+///
+/// @return the hash value.
+static size_t
+hash_pool_string(const char* s, size_t len)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < len; ++i)
+    {
+      h ^= static_cast<unsigned char>(s[i]);
+      h *= 0x100000001b3ULL;
+    }
+  return static_cast<size_t>(h);
+}
+
+/// An entry of the open addressing table of a @ref pool_shard.
+struct pool_slot
+{
+  /// The hash of the string this slot refers to, so that it's never
+  /// computed again, neither when probing nor when growing the table.
+  size_t	hash;
+  /// The string of the shard this slot refers to.  If it's nil then
+  /// the slot is empty.
+  string*	str;
+
+  pool_slot()
+    : hash(), str()
+  {}
+}; // end struct pool_slot
+
+/// The number of shards of an @ref interned_string_pool.  This must
+/// be a power of two.
+static const size_t NUM_POOL_SHARDS = 16;
+
+/// A shard of an @ref interned_string_pool.
+///
+/// Each shard holds the strings which hash falls into it.  The
+/// std::string objects are appended to a std::deque, which allocates
+/// them by blocks and never moves them, so that the pointers handed
+/// out to interned_string stay valid.  Note that this is not a
+/// character arena: as interned_string refers to a std::string, the
+/// characters of a string that is too long for the small string
+/// buffer of std::string are still allocated on their own.
+///
+/// The strings are indexed by an open addressing table with linear
+/// probing which slots hold the hash of the string they refer to.
+///
+/// Each shard has its own lock so that threads interning strings
+/// that fall into different shards don't contend with each other.
+struct pool_shard
+{
+  pthread_mutex_t	lock;
+  std::deque<string>	strings;
+  vector<pool_slot>	slots;
+  size_t		count;
+
+  pool_shard()
+    : count()
+  {
+    pthread_mutex_init(&lock, /*mutexattr=*/0);
+    slots.resize(64);
+  }
+
+  ~pool_shard()
+  {pthread_mutex_destroy(&lock);}
+
+  /// Find the slot of a string or the empty slot where it should be
+  /// inserted.
+  ///
+  /// The lock of the shard must be held by the caller.
+  ///
+  /// @param s the characters of the string to look for.
+  ///
+  /// @param len the number of characters of @p s.
+  ///
+  /// @param h the hash of the string to look for, as computed by
+  /// hash_pool_string.
+  ///
+  /// @return the slot of the string, or the empty slot where it
+  /// should be inserted.
+  pool_slot&
+  find_slot(const char* s, size_t len, size_t h)
+  {
+    size_t mask = slots.size() - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask)
+      {
+	pool_slot& slot = slots[i];
+	if (!slot.str
+	    || (slot.hash == h
+		&& slot.str->size() == len
+		&& slot.str->compare(0, len, s, len) == 0))
+	  return slot;
+      }
+  }
+
+  /// Double the size of the table of slots.
+  ///
+  /// The lock of the shard must be held by the caller.
+  void
+  grow()
+  {
+    vector<pool_slot> old(slots.size() * 2);
+    old.swap(slots);
+    size_t mask = slots.size() - 1;
+    for (vector<pool_slot>::const_iterator i = old.begin();
+	 i != old.end();
+	 ++i)
+      if (i->str)
+	{
+	  size_t j = i->hash & mask;
+	  while (slots[j].str)
+	    j = (j + 1) & mask;
+	  slots[j] = *i;
+	}
+  }
+}; // end struct pool_shard
 
 /// The type of the private data structure of type @ref
 /// intered_string_pool.
+///
+/// The strings of the pool are distributed among a fixed number of
+/// shards, which are selected using the high-order bits of their
+/// hash, whereas the low-order bits select their slot in the table of
+/// their shard.
 struct interned_string_pool::priv
 {
-  pool_map_type map;
+  pool_shard shards[NUM_POOL_SHARDS];
+
+  /// Get the shard that holds the strings with a given hash value.
+  ///
+  /// @param h the hash value to consider.
+  ///
+  /// @return the shard for @p h.
+  pool_shard&
+  get_shard(size_t h)
+  {return shards[(h >> (sizeof(size_t) * 8 - 8)) & (NUM_POOL_SHARDS - 1)];}
+
+  /// Lookup a string in the pool.
+  ///
+  /// @param s the characters of the string to look for.
+  ///
+  /// @param len the number of characters of @p s.
+  ///
+  /// @return a pointer to the string of the pool with value @p s, or
+  /// nil if it's not in the pool.
+  string*
+  lookup(const char* s, size_t len)
+  {
+    size_t h = hash_pool_string(s, len);
+    pool_shard& shard = get_shard(h);
+    pthread_mutex_lock(&shard.lock);
+    string* result = shard.find_slot(s, len, h).str;
+    pthread_mutex_unlock(&shard.lock);
+    return result;
+  }
+
+  /// Lookup a string in the pool and add it there if it's not
+  /// present yet.
+  ///
+  /// @param s the value of the string to look for.
+  ///
+  /// @return a pointer to the string of the pool with value @p s.
+  string*
+  lookup_or_insert(const string& s)
+  {
+    size_t h = hash_pool_string(s.data(), s.size());
+    pool_shard& shard = get_shard(h);
+    pthread_mutex_lock(&shard.lock);
+    pool_slot* slot = &shard.find_slot(s.data(), s.size(), h);
+    if (!slot->str)
+      {
+	if ((shard.count + 1) * 4 > shard.slots.size() * 3)
+	  {
+	    shard.grow();
+	    slot = &shard.find_slot(s.data(), s.size(), h);
+	  }
+	shard.strings.push_back(s);
+	slot->hash = h;
+	slot->str = &shard.strings.back();
+	++shard.count;
+      }
+    string* result = slot->str;
+    pthread_mutex_unlock(&shard.lock);
+    return result;
+  }
 }; //end struc struct interned_string_pool::priv
 
 /// Default constructor.
 interned_string_pool::interned_string_pool()
   : priv_(new priv)
-{
-  priv_->map[""] = 0;
-}
+{}
 
 /// Test if the interned string pool already contains a string with a
 /// given value.
 ///
+/// This function is safe to call concurrently from several threads.
+///
 /// @param s the string to test for.
 ///
 /// @return true if the pool contains a string with the value @p s.
 bool
 interned_string_pool::has_string(const char* s) const
-{return priv_->map.find(s) != priv_->map.end();}
+{
+  // The empty string is always considered as interned; it's
+  // represented by an empty interned_string.
+  if (!*s)
+    return true;
+  return priv_->lookup(s, strlen(s)) != 0;
+}
 
 /// Get a pointer to the interned string which has a given value.
 ///
+/// This function is safe to call concurrently from several threads.
+///
 /// @param s the value of the interned string to look for.
 ///
 /// @return a pointer to the raw string of characters which has the
@@ -158,38 +356,34 @@ interned_string_pool::has_string(const char* s) const
 const char*
 interned_string_pool::get_string(const char* s) const
 {
-  unordered_map<string, string*>::const_iterator i =
-    priv_->map.find(s);
-  if (i == priv_->map.end())
-    return 0;
-  if (i->second)
-    return i->second->c_str();
-  return "";
+  if (!*s)
+    return "";
+  if (string* result = priv_->lookup(s, strlen(s)))
+    return result->c_str();
+  return 0;
 }
 
 /// Create an interned string with a given value.
 ///
+/// This function is safe to call concurrently from several threads.
+///
 /// @param str_value the value of the interned string to create.
 ///
 /// @return the new created instance of @ref interned_string created.
 interned_string
 interned_string_pool::create_string(const std::string& str_value)
 {
-  string*& result = priv_->map[str_value];
-  if (!result && !str_value.empty())
-    result = new string(str_value);
-  return interned_string(result);
+  if (str_value.empty())
+    return interned_string();
+  return interned_string(priv_->lookup_or_insert(str_value));
 }
 
 /// Destructor.
+///
+/// The strings of the pool are released along with the deques of
+/// their shards.
 interned_string_pool::~interned_string_pool()
-{
-  for (pool_map_type::iterator i = priv_->map.begin();
-       i != priv_->map.end();
-       ++i)
-    if (i->second)
-      delete i->second;
-}
+{}
 
 /// Equality operator.
 ///
@@ -267,9 +461,13 @@ get_generic_anonymous_internal_type_name(const decl_base *d);
 /// @brief the location of a token represented in its simplest form.
 /// Instances of this type are to be stored in a sorted vector, so the
 /// type must have proper relational operators.
+///
+/// The path of the token is not held by the expanded location itself;
+/// it points to the copy of that path which is shared by all the
+/// locations of the same @ref location_manager.
 class expanded_location
 {
-  string	path_;
+  const string*	path_;
   unsigned	line_;
   unsigned	column_;
 
@@ -279,14 +477,14 @@ public:
 
   friend class location_manager;
 
-  expanded_location(const string& path, unsigned line, unsigned column)
+  expanded_location(const string* path, unsigned line, unsigned column)
   : path_(path), line_(line), column_(column)
   {}
 
   bool
   operator==(const expanded_location& l) const
   {
-    return (path_ == l.path_
+    return (*path_ == *l.path_
 	    && line_ == l.line_
 	    && column_ && l.column_);
   }
@@ -294,9 +492,9 @@ public:
   bool
   operator<(const expanded_location& l) const
   {
-    if (path_ < l.path_)
+    if (*path_ < *l.path_)
       return true;
-    else if (path_ > l.path_)
+    else if (*path_ > *l.path_)
       return false;
 
     if (line_ < l.line_)
@@ -348,6 +546,10 @@ struct location_manager::priv
   /// location in the table gives us an integer that is used to build
   /// instance of location types.
   std::vector<expanded_location> locs;
+
+  /// The file paths of the locations above.  Each distinct path is
+  /// stored once, rather than once per location.
+  std::unordered_set<string> paths;
 };
 
 location_manager::location_manager()
@@ -366,7 +568,8 @@ location_manager::create_new_location(const std::string&	file_path,
 				      size_t			line,
 				      size_t			col)
 {
-  expanded_location l(file_path, line, col);
+  const string* path = &*priv_->paths.insert(file_path).first;
+  expanded_location l(path, line, col);
 
   // Just append the new expanded location to the end of the vector
   // and return its index.  Note that indexes start at 1.
@@ -393,7 +596,7 @@ location_manager::expand_location(const location&	location,
   if (location.value_ == 0)
     return;
   expanded_location &l = priv_->locs[location.value_ - 1];
-  path = l.path_;
+  path = *l.path_;
   line = l.line_;
   column = l.column_;
 }
@@ -2773,11 +2976,180 @@ dm_context_rel::~dm_context_rel()
 typedef unordered_map<interned_string,
 		      bool, hash_interned_string> interned_string_bool_map_type;
 
+/// Convenience typedef for a pair of pointers to @ref type_base.
+typedef std::pair<const type_base*, const type_base*> type_base_ptr_pair;
+
+/// A hasher for @ref type_base_ptr_pair.
+struct type_base_ptr_pair_hash
+{
+  size_t
+  operator()(const type_base_ptr_pair& p) const
+  {
+    std::hash<const type_base*> h;
+    return hashing::combine_hashes(h(p.first), h(p.second));
+  }
+}; // end struct type_base_ptr_pair_hash
+
+/// A cache of the results of the structural comparisons of pairs of
+/// classes, unions or function types.
+///
+/// The same pair of (potentially big) types can be structurally
+/// compared many times while canonicalizing a type, e.g, when
+/// several data members have the same type.  This cache memoizes the
+/// result of a comparison once it's complete so that it doesn't have
+/// to be performed again.
+///
+/// A comparison result is memoized only if it didn't depend on the
+/// assumption that two types being already compared (further up in
+/// the comparison stack) are equal, as it's done to break cycles.
+/// That is detected by counting the number of such assumptions made
+/// during the comparison.
+///
+/// The cache is only enabled during the comparison of a type against
+/// the candidate canonical types in type_base::get_canonical_type_for.
+/// As that function can be re-entered, the cache counts how many of
+/// these comparisons are in progress, and is emptied when the
+/// outermost one is done.  During that time the types being compared
+/// are not destroyed, their structure is not modified, and the flags
+/// of the environment that influence type comparison don't change.
+///
+/// Note that on-the-fly canonicalization can set the canonical type
+/// of the types being compared during that time.  This doesn't
+/// invalidate the memoized results: a type only gets the canonical
+/// type of a type it was found equal to, and comparing two types that
+/// both have a canonical type compares their canonical types, which
+/// is meant to give the same result as comparing them structurally.
+/// And once both types of a pair have a canonical type, the cache is
+/// not looked up for them anymore.
+///
+/// The cache is bounded: when it's full, new results are not
+/// memoized anymore until it's emptied.
+class type_comparison_cache
+{
+  typedef unordered_map<type_base_ptr_pair,
+			bool,
+			type_base_ptr_pair_hash> results_map_type;
+
+  results_map_type	results_;
+  size_t		depth_;
+  size_t		num_cycle_assumptions_;
+  size_t		num_lookups_;
+  size_t		num_hits_;
+
+public:
+
+  /// The maximum number of comparison results held by the cache.
+  static const size_t MAX_SIZE = 100000;
+
+  type_comparison_cache()
+    : depth_(),
+      num_cycle_assumptions_(),
+      num_lookups_(),
+      num_hits_()
+  {}
+
+  /// Note that a comparison against candidate canonical types
+  /// begins.  This enables the cache.
+  void
+  enter()
+  {++depth_;}
+
+  /// Note that a comparison against candidate canonical types is
+  /// done.  When the outermost one is done, the cache is disabled
+  /// and emptied.
+  void
+  leave()
+  {
+    ABG_ASSERT(depth_);
+    if (--depth_ == 0)
+      results_.clear();
+  }
+
+  /// Note that a comparison assumed that two types were equal
+  /// because they were already being compared.
+  void
+  note_cycle_assumption()
+  {++num_cycle_assumptions_;}
+
+  /// Getter of the number of cycle assumptions made so far.
+  ///
+  /// @return the number of cycle assumptions made so far.
+  size_t
+  num_cycle_assumptions() const
+  {return num_cycle_assumptions_;}
+
+  /// Look up the memoized result of the comparison of two types.
+  ///
+  /// @param l the first type of the comparison.
+  ///
+  /// @param r the second type of the comparison.
+  ///
+  /// @param result output parameter.  Set to the memoized result of
+  /// the comparison if it was found.
+  ///
+  /// @return true iff the result of the comparison was found.
+  bool
+  lookup(const type_base* l, const type_base* r, bool& result)
+  {
+    if (!depth_)
+      return false;
+
+    ++num_lookups_;
+    results_map_type::const_iterator i =
+      results_.find(type_base_ptr_pair(l, r));
+    if (i == results_.end())
+      return false;
+
+    ++num_hits_;
+    result = i->second;
+    return true;
+  }
+
+  /// Memoize the result of the comparison of two types.
+  ///
+  /// @param l the first type of the comparison.
+  ///
+  /// @param r the second type of the comparison.
+  ///
+  /// @param result the result of the comparison.
+  void
+  add(const type_base* l, const type_base* r, bool result)
+  {
+    if (depth_ && results_.size() < MAX_SIZE)
+      results_[type_base_ptr_pair(l, r)] = result;
+  }
+
+  /// Getter of the number of look ups performed on the cache so
+  /// far.
+  ///
+  /// @return the number of look ups.
+  size_t
+  num_lookups() const
+  {return num_lookups_;}
+
+  /// Getter of the number of successful look ups performed on the
+  /// cache so far.
+  ///
+  /// @return the number of cache hits.
+  size_t
+  num_hits() const
+  {return num_hits_;}
+}; // end class type_comparison_cache
+
 /// The private data of the @ref environment type.
 struct environment::priv
 {
+  /// The canonical types, keyed by their interned internal pretty
+  /// representation.  Hashing and comparing these keys amounts to
+  /// hashing and comparing pointers.
+  typedef std::unordered_map<interned_string,
+			     vector<type_base_sptr>,
+			     hash_interned_string>
+  canonical_types_by_repr_map_type;
+
   config			 config_;
   canonical_types_map_type	 canonical_types_;
+  canonical_types_by_repr_map_type canonical_types_by_repr_;
   mutable vector<type_base_sptr> sorted_canonical_types_;
   type_base_sptr		 void_type_;
   type_base_sptr		 variadic_marker_type_;
@@ -2785,6 +3157,7 @@ struct environment::priv
   unordered_set<const function_type*>	fn_types_being_compared_;
   vector<type_base_sptr>	 extra_live_types_;
   interned_string_pool		 string_pool_;
+  type_comparison_cache		 type_comparison_cache_;
   bool				 canonicalization_is_done_;
   bool				 do_on_the_fly_canonicalization_;
   bool				 decl_only_class_equals_definition_;
@@ -2796,6 +3169,39 @@ struct environment::priv
   {}
 };// end struct environment::priv
 
+/// Compare two classes, unions or function types by comparing their
+/// canonical types if present.
+///
+/// If the canonical types are not present then the types are
+/// compared structurally, unless the result of that comparison is
+/// found in the type comparison cache of the environment.
+///
+/// @param l the first type to take into account in the comparison.
+///
+/// @param r the second type to take into account in the comparison.
+///
+/// @param cache the type comparison cache of the environment of @p l
+/// and @p r.
+template<typename T>
+bool
+try_memoized_canonical_compare(const T *l, const T *r,
+			       type_comparison_cache& cache)
+{
+  if (const type_base *lc = l->get_naked_canonical_type())
+    if (const type_base *rc = r->get_naked_canonical_type())
+      return lc == rc;
+
+  bool result = false;
+  if (cache.lookup(l, r, result))
+    return result;
+
+  size_t num_assumptions = cache.num_cycle_assumptions();
+  result = equals(*l, *r, 0);
+  if (cache.num_cycle_assumptions() == num_assumptions)
+    cache.add(l, r, result);
+  return result;
+}
+
 /// Default constructor of the @ref environment type.
 environment::environment()
   :priv_(new priv)
@@ -2807,8 +3213,15 @@ environment::~environment()
 
 /// Getter the map of canonical types.
 ///
+/// Type canonicalization looks canonical types up by their interned
+/// pretty representation, in a map that is private to the
+/// environment.  This map is kept up to date with that private map
+/// when new canonical types are added, but modifying it has no effect
+/// on type canonicalization.
+///
 /// @return the map of canonical types.  The key of the map is the
-/// hash of the canonical type and its value if the canonical type.
+/// pretty representation of the canonical types and its value is the
+/// vector of canonical types that have that representation.
 environment::canonical_types_map_type&
 environment::get_canonical_types_map()
 {return priv_->canonical_types_;}
@@ -2816,10 +3229,11 @@ environment::get_canonical_types_map()
 /// Getter the map of canonical types.
 ///
 /// @return the map of canonical types.  The key of the map is the
-/// hash of the canonical type and its value if the canonical type.
+/// pretty representation of the canonical types and its value is the
+/// vector of canonical types that have that representation.
 const environment::canonical_types_map_type&
 environment::get_canonical_types_map() const
-{return const_cast<environment*>(this)->get_canonical_types_map();}
+{return priv_->canonical_types_;}
 
 /// Helper to detect if a type is either a reference, a pointer, or a
 /// qualified type.
@@ -3186,6 +3600,23 @@ const config&
 environment::get_config() const
 {return priv_->config_;}
 
+/// Getter of statistics about the cache of type comparison results
+/// used during type canonicalization.
+///
+/// @param num_lookups output parameter.  Set to the number of times
+/// the result of a type comparison was looked up in the cache.
+///
+/// @param num_hits output parameter.  Set to the number of times the
+/// result of a type comparison was found in the cache.
+void
+environment::get_type_comparison_cache_stats(size_t& num_lookups,
+					     size_t& num_hits) const
+{
+  const type_comparison_cache& c = priv_->type_comparison_cache_;
+  num_lookups = c.num_lookups();
+  num_hits = c.num_hits();
+}
+
 // </environment stuff>
 
 // <type_or_decl_base stuff>
@@ -12609,33 +13040,44 @@ type_base::get_canonical_type_for(type_base_sptr t)
   // So in this case, the pretty representation of Foo is going to be
   // "class Foo", regardless of its struct-ness. This also applies to
   // composite types which would have "class Foo" as a sub-type.
-  string repr = t->get_cached_pretty_representation(/*internal=*/true);
+  //
+  // That representation is interned and cached in 't', so it's
+  // computed only once per type and looking it up in the map below
+  // only hashes and compares the pointer to the interned string.
+  interned_string repr =
+    t->get_cached_pretty_representation(/*internal=*/true);
 
   // If 't' already has a canonical type 'inside' its corpus
   // (t_corpus), then this variable is going to contain that canonical
   // type.
   type_base_sptr canonical_type_present_in_corpus;
-  environment::canonical_types_map_type& types =
-    env->get_canonical_types_map();
+  environment::priv::canonical_types_by_repr_map_type& types =
+    env->priv_->canonical_types_by_repr_;
 
   type_base_sptr result;
-  environment::canonical_types_map_type::iterator i = types.find(repr);
-  if (i == types.end())
+  // Look up the bucket of types having the same representation as
+  // 't' only once; the bucket is created empty if it's not there yet.
+  vector<type_base_sptr> &v = types[repr];
+  if (v.empty())
     {
-      vector<type_base_sptr> v;
       v.push_back(t);
-      types[repr] = v;
       result = t;
     }
   else
     {
-      vector<type_base_sptr> &v = i->second;
       // Let's compare 't' structurally (i.e, compare its sub-types
       // recursively) against the canonical types of the system. If it
       // equals a given canonical type C, then it means C is the
       // canonical type of 't'.  Otherwise, if 't' is different from
       // all the canonical types of the system, then it means 't' is a
       // canonical type itself.
+      //
+      // The results of the comparisons of classes, unions and
+      // function types performed during these comparisons are
+      // memoized until we are done with 't'.
+      type_comparison_cache& comparison_cache =
+	env->priv_->type_comparison_cache_;
+      comparison_cache.enter();
       for (vector<type_base_sptr>::const_reverse_iterator it = v.rbegin();
 	   it != v.rend();
 	   ++it)
@@ -12676,6 +13118,7 @@ type_base::get_canonical_type_for(type_base_sptr t)
 	      break;
 	    }
 	}
+      comparison_cache.leave();
       if (!result)
 	{
 	  v.push_back(t);
@@ -12683,6 +13126,10 @@ type_base::get_canonical_type_for(type_base_sptr t)
 	}
     }
 
+  // Keep the public map of canonical types up to date.
+  if (result == t)
+    env->priv_->canonical_types_[repr].push_back(t);
+
   return result;
 }
 
@@ -16997,7 +17444,10 @@ struct function_type::priv
   {
     const environment* env = type.get_environment();
     ABG_ASSERT(env);
-    return env->priv_->fn_types_being_compared_.count(&type);
+    if (!env->priv_->fn_types_being_compared_.count(&type))
+      return false;
+    env->priv_->type_comparison_cache_.note_cycle_assumption();
+    return true;
   }
 };// end struc function_type::priv
 
@@ -17446,7 +17896,10 @@ function_type::operator==(const type_base& other) const
   const function_type* o = dynamic_cast<const function_type*>(&other);
   if (!o)
     return false;
-  return try_canonical_compare(this, o);
+  const environment* env = get_environment();
+  ABG_ASSERT(env);
+  return try_memoized_canonical_compare(this, o,
+					env->priv_->type_comparison_cache_);
 }
 
 /// Return a copy of the pretty representation of the current @ref
@@ -18825,6 +19278,15 @@ struct class_or_union::priv
       return unmark_as_being_compared(*klass);
   }
 
+  /// Getter of the type comparison cache of a given environment.
+  ///
+  /// @param env the environment to consider.
+  ///
+  /// @return the type comparison cache of @p env.
+  static type_comparison_cache&
+  get_type_comparison_cache(const environment& env)
+  {return env.priv_->type_comparison_cache_;}
+
   /// Test if a given instance of class_or_union is being currently
   /// compared.
   ///
@@ -18836,7 +19298,10 @@ struct class_or_union::priv
   {
     const environment* env = klass.get_environment();
     ABG_ASSERT(env);
-    return env->priv_->classes_being_compared_.count(&klass);
+    if (!env->priv_->classes_being_compared_.count(&klass))
+      return false;
+    env->priv_->type_comparison_cache_.note_cycle_assumption();
+    return true;
   }
 
   /// Test if a given instance of class_or_union is being currently
@@ -21548,7 +22013,10 @@ class_decl::operator==(const decl_base& other) const
 
   ABG_ASSERT(r);
 
-  return try_canonical_compare(l, r);
+  const environment* env = get_environment();
+  ABG_ASSERT(env);
+  return try_memoized_canonical_compare(l, r,
+					env->priv_->type_comparison_cache_);
 }
 
 /// Equality operator for class_decl.
@@ -22330,7 +22798,10 @@ union_decl::operator==(const decl_base& other) const
   const union_decl* op = dynamic_cast<const union_decl*>(&other);
   if (!op)
     return false;
-  return try_canonical_compare(this, op);
+  const environment* env = get_environment();
+  ABG_ASSERT(env);
+  return try_memoized_canonical_compare
+    (this, op, class_or_union::priv::get_type_comparison_cache(*env));
 }
 
 /// Equality operator for union_decl.
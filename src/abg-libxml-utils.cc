@@ -123,6 +123,47 @@ new_reader_from_istream(std::istream* in)
   return p;
 }
 
+/// A deleter for an xmlTextReader that walks an XML document it
+/// owns.
+struct walkerDeleter
+{
+  xmlDocPtr doc;
+
+  walkerDeleter(xmlDocPtr d)
+    : doc(d)
+  {}
+
+  void
+  operator()(xmlTextReaderPtr reader)
+  {
+    xmlFreeTextReader(reader);
+    xmlFreeDoc(doc);
+  }
+}; // end struct walkerDeleter
+
+/// Instantiate an xmlTextReader that walks an XML document which has
+/// already been built in memory, wrap it into a smart pointer and
+/// return it.
+///
+/// @param doc the XML document to walk.  The returned reader takes
+/// ownership of it, so the document is freed along with the reader.
+///
+/// @return the new reader, or nil if @p doc is nil.
+reader_sptr
+new_reader_from_doc(xmlDocPtr doc)
+{
+  if (!doc)
+    return reader_sptr();
+
+  xmlTextReaderPtr reader = xmlReaderWalker(doc);
+  if (!reader)
+    {
+      xmlFreeDoc(doc);
+      return reader_sptr();
+    }
+  return reader_sptr(reader, walkerDeleter(doc));
+}
+
 /// Convert a shared pointer to xmlChar into an std::string.
 ///
 /// If the xmlChar is NULL, set "" to the string.
@@ -26,6 +26,7 @@
 
 #include "abg-internal.h"
 #include "abg-tools-utils.h"
+#include "abg-binary-format.h"
 
 // <headers defining libabigail's API go under here>
 ABG_BEGIN_EXPORT_DECLARATIONS
@@ -101,6 +102,7 @@ private:
   xml_node_decl_base_sptr_map				m_xml_node_decl_map;
   xml::reader_sptr					m_reader;
   xmlNodePtr						m_corp_node;
+  bool							m_corp_node_is_read;
   deque<shared_ptr<decl_base> >			m_decls_stack;
   corpus_sptr						m_corpus;
   corpus_group_sptr					m_corpus_group;
@@ -118,6 +120,7 @@ public:
     : m_env(env),
       m_reader(reader),
       m_corp_node(),
+      m_corp_node_is_read(),
       m_exported_decls_builder(),
       m_tracking_non_reachable_types(),
       m_drop_undefined_syms(),
@@ -220,7 +223,39 @@ public:
 
   void
   set_corpus_node(xmlNodePtr node)
-  {m_corp_node = node;}
+  {
+    m_corp_node = node;
+    m_corp_node_is_read = true;
+  }
+
+  /// Set the current corpus node to the first child node of a corpus
+  /// element.
+  ///
+  /// Unlike with set_corpus_node, the node itself has not been read
+  /// yet, so it is the first node returned by get_next_corpus_node.
+  /// This doesn't assume the first child element to be preceded by
+  /// a blank text node, as there is none in non-indented documents.
+  ///
+  /// @param node the first child node of the corpus element.
+  void
+  set_corpus_first_child_node(xmlNodePtr node)
+  {
+    m_corp_node = node;
+    m_corp_node_is_read = false;
+  }
+
+  /// Getter of the first node to consider when looking for the next
+  /// element of the current corpus.
+  ///
+  /// @return the node that follows the current corpus node, or the
+  /// current corpus node itself if it hasn't been read yet.
+  xmlNodePtr
+  get_next_corpus_node() const
+  {
+    if (!m_corp_node)
+      return 0;
+    return m_corp_node_is_read ? m_corp_node->next : m_corp_node;
+  }
 
   const string_xml_node_map&
   get_id_xml_node_map() const
@@ -1503,7 +1538,7 @@ read_translation_unit_from_input(read_context&	ctxt)
   else
     {
       node = 0;
-      for (xmlNodePtr n = ctxt.get_corpus_node()->next; n; n = n->next)
+      for (xmlNodePtr n = ctxt.get_next_corpus_node(); n; n = n->next)
 	{
 	  if (!n
 	      || n->type != XML_ELEMENT_NODE)
@@ -1601,7 +1636,7 @@ read_symbol_db_from_input(read_context&		 ctxt,
 	xmlTextReaderNext(reader.get());
       }
   else
-    for (xmlNodePtr n = ctxt.get_corpus_node()->next; n; n = n->next)
+    for (xmlNodePtr n = ctxt.get_next_corpus_node(); n; n = n->next)
       {
 	if (!n || n->type != XML_ELEMENT_NODE)
 	  continue;
@@ -1706,7 +1741,7 @@ read_elf_needed_from_input(read_context&	ctxt,
     }
   else
     {
-      for (xmlNodePtr n = ctxt.get_corpus_node()->next; n; n = n->next)
+      for (xmlNodePtr n = ctxt.get_next_corpus_node(); n; n = n->next)
 	{
 	  if (!n || n->type != XML_ELEMENT_NODE)
 	    continue;
@@ -1925,11 +1960,16 @@ read_corpus_from_input(read_context& ctxt)
 	corp.set_soname(reinterpret_cast<char*>(soname_str.get()));
     }
 
-  if (!node->children)
+  if (node->children)
+    ctxt.set_corpus_first_child_node(node->children);
+  else if (!call_reader_next)
+    // This is an empty corpus of a corpus group.  It has no child
+    // node at all if the document has no blank text node, so the
+    // nodes that follow are those of the next corpus of the group.
+    ctxt.set_corpus_node(node);
+  else
     return nil;
 
-  ctxt.set_corpus_node(node->children);
-
   corpus& corp = *ctxt.get_corpus();
 
   walk_xml_node_to_map_type_ids(ctxt, node);
@@ -2045,8 +2085,9 @@ read_corpus_group_from_input(read_context& ctxt)
   if (!node)
     return nil;
 
-  //node = xml::get_first_element_sibling_if_text(node->children);
-  node = xml::advance_to_next_sibling_element(node->children);
+  node = node->children;
+  if (node && node->type != XML_ELEMENT_NODE)
+    node = xml::advance_to_next_sibling_element(node);
   ctxt.set_corpus_node(node);
 
   corpus_sptr corp;
@@ -5868,6 +5909,30 @@ create_native_xml_read_context(std::istream* in, environment* env)
   return result;
 }
 
+/// Create an xml_reader::read_context to read an ABI corpus, or an
+/// ABI corpus group, from a file in the native binary corpus format.
+///
+/// The resulting context is used like one created by
+/// create_native_xml_read_context, e.g, with read_corpus_from_input
+/// or read_corpus_group_from_input.
+///
+/// @param path the path to the native binary corpus file to read.
+///
+/// @param env the environment to use.
+///
+/// @return the created context.
+read_context_sptr
+create_native_binary_read_context(const string& path, environment *env)
+{
+  xmlDocPtr doc = binary_format::read_binary_as_xml_document(path);
+  read_context_sptr result(new read_context(xml::new_reader_from_doc(doc),
+					    env));
+  corpus_sptr corp(new corpus(env));
+  result->set_corpus(corp);
+  result->set_path(path);
+  return result;
+}
+
 /// Getter for the path to the binary this @ref read_context is for.
 ///
 /// @return the path to the binary the @ref read_context is for.
@@ -5917,6 +5982,27 @@ read_corpus_from_native_xml_file(const string& path,
   return corp;
 }
 
+/// De-serialize an ABI corpus from a file in the native binary corpus
+/// format.
+///
+/// @param path the path to the input file to read.
+///
+/// @param env the environment to use.  Note that the life time of
+/// this environment must be greater than the lifetime of the
+/// resulting corpus as the corpus uses resources that are allocated
+/// in the environment.
+///
+/// @return the resulting corpus de-serialized from the file.  This is
+/// non-null if the reading successfully resulted in a corpus.
+corpus_sptr
+read_corpus_from_native_binary_file(const string& path,
+				    environment* env)
+{
+  read_context_sptr read_ctxt = create_native_binary_read_context(path, env);
+  corpus_sptr corp = read_corpus_from_input(*read_ctxt);
+  return corp;
+}
+
 }//end namespace xml_reader
 
 }//end namespace abigail
@@ -12,6 +12,7 @@
 
 #include <sstream>
 #include <ostream>
+#include <unordered_set>
 
 #include "abg-internal.h"
 
@@ -99,6 +100,165 @@ generate_from_strings(const std::vector<std::string>& strs)
   return os.str();
 }
 
+/// Get the literal string that any string matched by an extended
+/// regex must start with.
+///
+/// This only considers regexes anchored at the beginning of the
+/// string and having no alternation at all, as is the case of most
+/// of the name and file name regexes of suppression specifications.
+/// The prefix stops at the first character that is not an ordinary
+/// or an escaped special character.  A character that is followed by
+/// a repetition operator is not part of the prefix.
+///
+/// @param str the string representation of the regex.
+///
+/// @return the literal prefix, or an empty string if none could be
+/// deduced from @p str.
+static std::string
+get_anchored_literal_prefix(const std::string& str)
+{
+  static const std::string specials = "^.[]$()|*+?{}\\";
+  static const std::string repetitions = "*+?{";
+
+  if (str.empty() || str[0] != '^')
+    return "";
+
+  // An alternation could lift the anchor of the first branch.  Be
+  // conservative and do not look at regexes using '|' at all.
+  for (std::string::size_type i = 0; i < str.size(); ++i)
+    {
+      if (str[i] == '\\')
+	++i;
+      else if (str[i] == '|')
+	return "";
+    }
+
+  std::string prefix;
+  std::string::size_type i = 1;
+  while (i < str.size())
+    {
+      char c = str[i];
+      std::string::size_type next = i + 1;
+      if (c == '\\')
+	{
+	  // Only escaped special characters are plain literals; other
+	  // escape sequences like \w or \< are GNU extensions.
+	  if (next >= str.size()
+	      || specials.find(str[next]) == std::string::npos)
+	    break;
+	  c = str[next];
+	  ++next;
+	}
+      else if (specials.find(c) != std::string::npos)
+	break;
+
+      if (next < str.size()
+	  && repetitions.find(str[next]) != std::string::npos)
+	break;
+
+      prefix += c;
+      i = next;
+    }
+  return prefix;
+}
+
+/// Get the set of literal strings that an extended regex matches, if
+/// the regex matches nothing else.
+///
+/// This recognizes regexes of the form "^literal$" and
+/// "^(literal1|literal2|...)$" where the literals are made of
+/// ordinary and escaped special characters only.  This is the form of
+/// the regexes built by generate_from_strings, e.g, for Linux kernel
+/// ABI whitelists.
+///
+/// @param str the string representation of the regex.
+///
+/// @return the set of strings matched by the regex, or null if the
+/// regex is not of the form described above.
+static std::shared_ptr<std::unordered_set<std::string> >
+get_literal_alternatives(const std::string& str)
+{
+  static const std::string specials = "^.[]$()|*+?{}\\";
+  typedef std::shared_ptr<std::unordered_set<std::string> > set_sptr;
+
+  if (str.empty() || str[0] != '^')
+    return set_sptr();
+
+  std::string::size_type i = 1;
+  bool grouped = i < str.size() && str[i] == '(';
+  if (grouped)
+    ++i;
+
+  set_sptr result(new std::unordered_set<std::string>);
+  std::string literal;
+  for (; i < str.size(); ++i)
+    {
+      char c = str[i];
+      if (c == '\\')
+	{
+	  if (i + 1 >= str.size()
+	      || specials.find(str[i + 1]) == std::string::npos)
+	    return set_sptr();
+	  literal += str[++i];
+	}
+      else if (specials.find(c) == std::string::npos)
+	literal += c;
+      else if (grouped && (c == '|' || c == ')'))
+	{
+	  // Empty alternatives are not portable; leave them to regexec.
+	  if (literal.empty())
+	    return set_sptr();
+	  result->insert(literal);
+	  literal.clear();
+	  if (c == ')')
+	    {
+	      // The group must be followed by the end anchor and
+	      // nothing else.
+	      if (i + 2 == str.size() && str[i + 1] == '$')
+		return result;
+	      return set_sptr();
+	    }
+	}
+      else if (!grouped && c == '$' && i + 1 == str.size())
+	{
+	  result->insert(literal);
+	  return result;
+	}
+      else
+	return set_sptr();
+    }
+
+  return set_sptr();
+}
+
+/// The delete functor of the shared pointers to the regexes built by
+/// compile.
+///
+/// As this functor lives as long as the regex_t it de-allocates, it
+/// also carries facts about the regex that let match reject or
+/// accept some strings without calling regexec.  It's private to
+/// this file so that these facts are not part of the API; match finds
+/// them back with std::get_deleter, which only succeeds for the
+/// regexes built by compile.
+struct compiled_regex_deleter
+{
+  /// A string that every string matched by the regex starts with.
+  /// This is empty if no such string could be deduced from the regex.
+  std::string literal_prefix;
+
+  /// If the regex matches a finite set of literal strings and
+  /// nothing else, this is that set.  Otherwise, this is null.
+  std::shared_ptr<std::unordered_set<std::string> > literals;
+
+  /// The operator called to de-allocate the pointer to regex_t
+  /// embedded in a shared_ptr<regex_t>
+  ///
+  /// @param r the pointer to regex_t to de-allocate.
+  void
+  operator()(::regex_t* r)
+  {regex_t_deleter()(r);}
+};// end struct compiled_regex_deleter
+
 /// Compile a regex from a string.
 ///
 /// The result is held in a shared pointer. This will be null if regex
@@ -110,10 +270,17 @@ generate_from_strings(const std::vector<std::string>& strs)
 regex_t_sptr
 compile(const std::string& str)
 {
-  regex_t_sptr r = sptr_utils::build_sptr(new regex_t);
-  if (regcomp(r.get(), str.c_str(), REG_EXTENDED))
-    r.reset();
-  return r;
+  regex_t* p = new regex_t;
+  if (regcomp(p, str.c_str(), REG_EXTENDED))
+    {
+      delete p;
+      return regex_t_sptr();
+    }
+  compiled_regex_deleter d;
+  d.literals = get_literal_alternatives(str);
+  if (!d.literals)
+    d.literal_prefix = get_anchored_literal_prefix(str);
+  return regex_t_sptr(p, d);
 }
 
 /// See if a string matches a regex.
@@ -126,6 +293,24 @@ compile(const std::string& str)
 bool
 match(const regex_t_sptr& r, const std::string& str)
 {
+  // Strings that do not start with the literal prefix of the regex
+  // cannot match it.  Suppression specifications are evaluated
+  // against every decl and type of a corpus so this saves a lot of
+  // calls to regexec.
+  if (const compiled_regex_deleter* d =
+      std::get_deleter<compiled_regex_deleter>(r))
+    {
+      // Regexes that are just a set of literal strings, like those
+      // generated from Linux kernel ABI whitelists, are matched by
+      // looking the string up in that set.
+      if (d->literals)
+	return d->literals->count(str);
+
+      if (!d->literal_prefix.empty()
+	  && str.compare(0, d->literal_prefix.size(), d->literal_prefix))
+	return false;
+    }
+
   return !regexec(r.get(), str.c_str(), 0, NULL, 0);
 }
 
@@ -46,6 +46,7 @@
 #include "abg-dwarf-reader.h"
 #include "abg-internal.h"
 #include "abg-regex.h"
+#include "abg-binary-format.h"
 
 // <headers defining libabigail's API go under here>
 ABG_BEGIN_EXPORT_DECLARATIONS
@@ -1348,6 +1349,12 @@ operator<<(ostream& output,
     case FILE_TYPE_TAR:
       repr = "GNU tar archive type";
       break;
+    case FILE_TYPE_BINARY_CORPUS:
+      repr = "native binary corpus file type";
+      break;
+    case FILE_TYPE_BINARY_CORPUS_GROUP:
+      repr = "native binary corpus group file type";
+      break;
     }
 
   output << repr;
@@ -1381,6 +1388,12 @@ guess_file_type(istream& in)
       && buf[3] == 'F')
     return FILE_TYPE_ELF;
 
+  char binary_kind = 0;
+  if (binary_format::get_file_kind(buf, in.gcount(), binary_kind))
+    return (binary_kind == binary_format::CORPUS_GROUP_KIND
+	    ? FILE_TYPE_BINARY_CORPUS_GROUP
+	    : FILE_TYPE_BINARY_CORPUS);
+
   if (buf[0] == '!'
       && buf[1] == '<'
       && buf[2] == 'a'
@@ -2008,6 +2021,9 @@ gen_suppr_spec_from_kernel_abi_whitelists
 
       // Build a regular expression representing the union of all
       // the function and variable names expressed in the white list.
+      // As it is made of literals only, regex::match evaluates it by
+      // looking names up in a hash set rather than by running the
+      // regex engine.
       const std::string regex = regex::generate_from_strings(whitelisted_names);
 
       // Build a suppression specification which *keeps* functions
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "abg-tools-utils.h"
+#include "abg-binary-format.h"
 
 #include "abg-internal.h"
 // <headers defining libabigail's API go under here>
@@ -154,6 +155,7 @@ class write_context
   bool					m_write_parameter_names;
   bool					m_short_locs;
   bool					m_write_default_sizes;
+  bool					m_binary_output;
   type_id_style_kind			m_type_id_style;
   mutable type_ptr_map			m_type_id_map;
   mutable unordered_set<uint32_t>	m_used_type_id_hashes;
@@ -194,6 +196,7 @@ public:
       m_write_parameter_names(true),
       m_short_locs(false),
       m_write_default_sizes(true),
+      m_binary_output(false),
       m_type_id_style(SEQUENCE_TYPE_ID_STYLE)
   {}
 
@@ -281,6 +284,21 @@ public:
   set_write_default_sizes(bool f)
   {m_write_default_sizes = f;}
 
+  /// Getter of the binary-output option.
+  ///
+  /// @return true iff corpora and corpus groups shall be emitted in
+  /// the native binary corpus format rather than in abixml.
+  bool
+  get_binary_output() const
+  {return m_binary_output;}
+
+  /// Setter of the binary-output option.
+  ///
+  /// @param f the new value of the flag.
+  void
+  set_binary_output(bool f)
+  {m_binary_output = f;}
+
   /// Getter of the write-corpus-path option.
   ///
   /// @return true iff corpus-path information shall be emitted
@@ -2173,6 +2191,20 @@ void
 set_write_default_sizes(write_context& ctxt, bool flag)
 {ctxt.set_write_default_sizes(flag);}
 
+/// Set the 'binary-output' flag.
+///
+/// When this flag is set then write_corpus and write_corpus_group
+/// emit their output in the native binary corpus format instead of
+/// abixml.  That format can be read back using
+/// xml_reader::create_native_binary_read_context.
+///
+/// @param ctxt the context to set this flag on to.
+///
+/// @param flag the new value of the 'binary-output' flag.
+void
+set_binary_output(write_context& ctxt, bool flag)
+{ctxt.set_binary_output(flag);}
+
 /// Set the 'type-id-style' property.
 ///
 /// This property controls the kind of type ids used in XML output.
@@ -4332,6 +4364,41 @@ write_version_info(write_context& ctxt)
     << "'";
 }
 
+/// Serialize an ABI corpus in the native binary corpus format.
+///
+/// The corpus is first written as abixml into a string, with the
+/// binary-output flag of the context temporarily unset, and that
+/// document is then converted.
+///
+/// @param ctxt the write context to use.  Its output stream is where
+/// the native binary corpus format is written.
+///
+/// @param corpus the corpus to serialize.
+///
+/// @param indent the number of white space indentation to use.
+///
+/// @return true upon successful completion, false otherwise.
+static bool
+write_corpus_as_binary(write_context&		ctxt,
+		       const corpus_sptr&	corpus,
+		       unsigned		indent)
+{
+  ostream& out = ctxt.get_ostream();
+  std::ostringstream xml;
+
+  ctxt.set_ostream(xml);
+  ctxt.set_binary_output(false);
+  bool is_ok = write_corpus(ctxt, corpus, indent);
+  ctxt.set_binary_output(true);
+  ctxt.set_ostream(out);
+
+  // An empty corpus yields no output.
+  if (!is_ok || xml.str().empty())
+    return is_ok;
+
+  return binary_format::write_xml_document_as_binary(xml.str(), out);
+}
+
 /// Serialize an ABI corpus to a single native xml document.  The root
 /// note of the resulting XML document is 'abi-corpus'.
 ///
@@ -4355,6 +4422,9 @@ write_corpus(write_context&	ctxt,
   if (!corpus)
     return false;
 
+  if (ctxt.get_binary_output() && !member_of_group)
+    return write_corpus_as_binary(ctxt, corpus, indent);
+
   if (corpus->is_empty())
     return true;
 
@@ -4450,6 +4520,40 @@ write_corpus(write_context&	ctxt,
   return true;
 }
 
+/// Serialize an ABI corpus group in the native binary corpus format.
+///
+/// The group is first written as abixml into a string, with the
+/// binary-output flag of the context temporarily unset, and that
+/// document is then converted.
+///
+/// @param ctxt the write context to use.  Its output stream is where
+/// the native binary corpus format is written.
+///
+/// @param group the corpus group to serialize.
+///
+/// @param indent the number of white space indentation to use.
+///
+/// @return true upon successful completion, false otherwise.
+static bool
+write_corpus_group_as_binary(write_context&		ctxt,
+			     const corpus_group_sptr&	group,
+			     unsigned			indent)
+{
+  ostream& out = ctxt.get_ostream();
+  std::ostringstream xml;
+
+  ctxt.set_ostream(xml);
+  ctxt.set_binary_output(false);
+  bool is_ok = write_corpus_group(ctxt, group, indent);
+  ctxt.set_binary_output(true);
+  ctxt.set_ostream(out);
+
+  if (!is_ok)
+    return false;
+
+  return binary_format::write_xml_document_as_binary(xml.str(), out);
+}
+
 /// Serialize an ABI corpus group to a single native xml document.
 /// The root note of the resulting XML document is 'abi-corpus-group'.
 ///
@@ -4469,6 +4573,9 @@ write_corpus_group(write_context&	    ctxt,
   if (!group)
     return false;
 
+  if (ctxt.get_binary_output())
+    return write_corpus_group_as_binary(ctxt, group, indent);
+
   do_indent_to_level(ctxt, indent, 0);
 
 std::ostream& out = ctxt.get_ostream();
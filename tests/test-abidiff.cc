@@ -128,6 +128,12 @@ static InOutSpec specs[] =
     "data/test-abidiff/test-crc-report.txt",
     "output/test-abidiff/test-crc-report-1-2.txt"
   },
+  {
+    "data/test-abidiff/test-reordered-decls-v0.xml",
+    "data/test-abidiff/test-reordered-decls-v1.xml",
+    "data/test-abidiff/test-reordered-decls-report.txt",
+    "output/test-abidiff/test-reordered-decls-report.txt"
+  },
   // This should be the last entry.
   {0, 0, 0, 0}
 };
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program tests that diff_context::maybe_apply_filters, which
+/// applies all the categorization filters of a diff context in a
+/// single walk of the diff tree, categorizes the diff nodes the same
+/// way as applying each filter in turn with filtering::apply_filter
+/// and propagating the categories after each of them.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "abg-comp-filter.h"
+#include "abg-comparison.h"
+#include "abg-corpus.h"
+#include "abg-dwarf-reader.h"
+#include "lib/catch.hpp"
+#include "test-utils.h"
+
+using std::string;
+using std::vector;
+using namespace abigail;
+using namespace abigail::comparison;
+
+/// A filter that puts the nodes it visits into the
+/// SIZE_OR_OFFSET_CHANGE_CATEGORY category, and stops the traversal
+/// once it has visited a given number of nodes.  It logs the nodes it
+/// sees so that its traversals can be compared.
+struct stopping_filter : public filtering::filter_base
+{
+  size_t	num_nodes_before_stop;
+  vector<string> log;
+
+  stopping_filter(size_t n)
+    : num_nodes_before_stop(n)
+  {}
+
+  virtual void
+  visit_begin(diff* d)
+  {log.push_back("begin " + d->get_pretty_representation());}
+
+  virtual void
+  visit_begin(corpus_diff*)
+  {log.push_back("begin corpus");}
+
+  virtual bool
+  visit(diff* d, bool pre)
+  {
+    log.push_back(string(pre ? "pre " : "post ")
+		  + d->get_pretty_representation());
+    if (!pre)
+      return true;
+    if (num_nodes_before_stop == 0)
+      return false;
+    --num_nodes_before_stop;
+    d->add_to_category(SIZE_OR_OFFSET_CHANGE_CATEGORY);
+    return true;
+  }
+
+  virtual void
+  visit_end(diff* d)
+  {log.push_back("end " + d->get_pretty_representation());}
+
+  virtual void
+  visit_end(corpus_diff*)
+  {log.push_back("end corpus");}
+};
+
+/// A visitor that records the categories of all the nodes of a diff
+/// tree, in the order of the traversal.
+struct category_recorder : public diff_node_visitor
+{
+  vector<string> categories;
+
+  virtual bool
+  visit(diff* d, bool pre)
+  {
+    if (pre)
+      {
+	std::ostringstream o;
+	o << d->get_pretty_representation() << ": " << d->get_category();
+	categories.push_back(o.str());
+      }
+    return true;
+  }
+};
+
+/// Compute the diff between two corpora and categorize its nodes.
+///
+/// @param c0 the first corpus to compare.
+///
+/// @param c1 the second corpus to compare.
+///
+/// @param filter a filter to add after the default filters of the
+/// diff context, or nil.
+///
+/// @param in_one_walk if true, apply the filters with
+/// diff_context::maybe_apply_filters.  Otherwise, apply them one
+/// after the other.
+///
+/// @return the categories of the nodes of the diff, in traversal
+/// order.
+static vector<string>
+categorize(const corpus_sptr& c0, const corpus_sptr& c1,
+	   const filtering::filter_base_sptr& filter, bool in_one_walk)
+{
+  diff_context_sptr ctxt(new diff_context);
+  if (filter)
+    ctxt->add_diff_filter(filter);
+  const filtering::filters& filters = ctxt->diff_filters();
+
+  corpus_diff_sptr d = compute_diff(c0, c1, ctxt);
+  REQUIRE(d);
+  REQUIRE(d->has_changes());
+
+  if (in_one_walk)
+    ctxt->maybe_apply_filters(d);
+  else
+    for (filtering::filters::const_iterator i = filters.begin();
+	 i != filters.end();
+	 ++i)
+      {
+	filtering::apply_filter(**i, d);
+	propagate_categories(d);
+      }
+
+  category_recorder r;
+  bool s = ctxt->visiting_a_node_twice_is_forbidden();
+  ctxt->forbid_visiting_a_node_twice(false);
+  d->traverse(r);
+  ctxt->forbid_visiting_a_node_twice(s);
+  return r.categories;
+}
+
+/// Read the corpus of an ELF binary of the test data.
+///
+/// @param path the path of the binary, relative to tests/data.
+///
+/// @param env the environment to read the corpus in.
+///
+/// @return the corpus read.
+static corpus_sptr
+read_corpus(const string& path, ir::environment& env)
+{
+  string elf_path =
+    string(abigail::tests::get_src_dir()) + "/tests/data/" + path;
+  vector<char**> debug_info_root_paths;
+  dwarf_reader::status status = dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr c =
+    dwarf_reader::read_corpus_from_elf(elf_path, debug_info_root_paths,
+				       &env, /*load_all_types=*/false, status);
+  REQUIRE(c);
+  REQUIRE((status & dwarf_reader::STATUS_OK));
+  return c;
+}
+
+/// Pairs of binaries whose diff trees have harmless and harmful
+/// changes, redundant nodes and cycles.
+static const char* binaries[][2] =
+{
+  {"test-diff-filter/libtest23-redundant-fn-parm-change-v0.so",
+   "test-diff-filter/libtest23-redundant-fn-parm-change-v1.so"},
+  {"test-diff-filter/libtest25-cyclic-type-v0.so",
+   "test-diff-filter/libtest25-cyclic-type-v1.so"},
+  {"test-diff-filter/libtest27-redundant-and-filtered-children-nodes-v0.so",
+   "test-diff-filter/libtest27-redundant-and-filtered-children-nodes-v1.so"},
+  {"test-diff-filter/libtest32-struct-change-v0.so",
+   "test-diff-filter/libtest32-struct-change-v1.so"},
+  {"test-diff-dwarf/libtest40-v0.so",
+   "test-diff-dwarf/libtest40-v1.so"},
+};
+
+TEST_CASE("FiltersAppliedInOneWalk", "[apply_filters]")
+{
+  for (size_t i = 0; i < sizeof(binaries) / sizeof(binaries[0]); ++i)
+    {
+      INFO("binaries: " << binaries[i][0] << ", " << binaries[i][1]);
+      ir::environment env;
+      corpus_sptr c0 = read_corpus(binaries[i][0], env);
+      corpus_sptr c1 = read_corpus(binaries[i][1], env);
+
+      filtering::filter_base_sptr none;
+      CHECK(categorize(c0, c1, none, /*in_one_walk=*/true)
+	    == categorize(c0, c1, none, /*in_one_walk=*/false));
+    }
+}
+
+TEST_CASE("FilterStoppingItsWalk", "[apply_filters]")
+{
+  for (size_t i = 0; i < sizeof(binaries) / sizeof(binaries[0]); ++i)
+    {
+      INFO("binaries: " << binaries[i][0] << ", " << binaries[i][1]);
+      ir::environment env;
+      corpus_sptr c0 = read_corpus(binaries[i][0], env);
+      corpus_sptr c1 = read_corpus(binaries[i][1], env);
+
+      // Stop the filter before the first node, inside the tree, and
+      // after the last node.
+      size_t stops[] = {0, 2, 1000000};
+      for (size_t j = 0; j < sizeof(stops) / sizeof(stops[0]); ++j)
+	{
+	  INFO("stopping after " << stops[j] << " nodes");
+	  shared_ptr<stopping_filter> f0(new stopping_filter(stops[j]));
+	  shared_ptr<stopping_filter> f1(new stopping_filter(stops[j]));
+
+	  // Stopping the traversal for that filter must not stop it
+	  // for the default filters.
+	  CHECK(categorize(c0, c1, f0, /*in_one_walk=*/true)
+		== categorize(c0, c1, f1, /*in_one_walk=*/false));
+	  CHECK(f0->log == f1->log);
+	}
+    }
+}
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program runs abidiff twice on the same binaries with the same
+/// on-disk cache of corpora.  It checks that the first run reads the
+/// binaries and fills the cache, that the second run loads the
+/// corpora from the cache, and that both runs emit the expected
+/// report.
+///
+/// The set of input files and reference reports to consider should be
+/// present in the source distribution.
+
+#include <sys/wait.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "abg-tools-utils.h"
+#include "test-utils.h"
+
+using std::string;
+using std::cerr;
+
+/// This is an aggregate that specifies where a test shall get its
+/// input from and where it shall write its ouput to.
+struct InOutSpec
+{
+  const char*	in_elfv0_path;
+  const char*	in_elfv1_path;
+  const char*	in_suppr_path;
+  const char*	in_report_path;
+  const char*	out_report_path;
+};// end struct InOutSpec;
+
+InOutSpec in_out_specs[] =
+{
+  {
+    "data/test-diff-dwarf/libtest40-v0.so",
+    "data/test-diff-dwarf/libtest40-v1.so",
+    "",
+    "data/test-corpus-cache/test0-report-0.txt",
+    "output/test-corpus-cache/test0-report-0.txt"
+  },
+  // The same binaries, with a suppression specification that drops a
+  // type from the corpora.  The corpora cached by the previous test
+  // must not be used.
+  {
+    "data/test-diff-dwarf/libtest40-v0.so",
+    "data/test-diff-dwarf/libtest40-v1.so",
+    "data/test-corpus-cache/test0-drop-S2.suppr",
+    "data/test-corpus-cache/test0-report-1.txt",
+    "output/test-corpus-cache/test0-report-1.txt"
+  },
+  // This should be the last entry.
+  {NULL, NULL, NULL, NULL, NULL}
+};
+
+/// Count the corpora that abidiff loaded from the cache, according to
+/// its log.
+///
+/// @param log_path the path to the error output of abidiff --verbose.
+///
+/// @return the number of corpora loaded from the cache.
+static int
+count_corpora_loaded_from_cache(const string& log_path)
+{
+  std::ifstream log(log_path.c_str());
+  int result = 0;
+  string line;
+  while (std::getline(log, line))
+    if (line.find("loaded corpus of ") == 0)
+      ++result;
+  return result;
+}
+
+int
+main()
+{
+  using abigail::tests::get_src_dir;
+  using abigail::tests::get_build_dir;
+  using abigail::tools_utils::ensure_parent_dir_created;
+
+  bool is_ok = true;
+  string source_dir_prefix = string(get_src_dir()) + "/tests/";
+  string build_dir_prefix = string(get_build_dir()) + "/tests/";
+  string cache_dir = build_dir_prefix + "output/test-corpus-cache/cache";
+
+  // Start from an empty cache.
+  string cmd = "rm -rf " + cache_dir;
+  if (system(cmd.c_str()))
+    return 1;
+
+  for (InOutSpec* s = in_out_specs; s->in_elfv0_path; ++s)
+    {
+      string in_elfv0_path = source_dir_prefix + s->in_elfv0_path;
+      string in_elfv1_path = source_dir_prefix + s->in_elfv1_path;
+      string ref_report_path = source_dir_prefix + s->in_report_path;
+      string out_report_path = build_dir_prefix + s->out_report_path;
+      string log_path = out_report_path + ".log";
+
+      if (!ensure_parent_dir_created(out_report_path))
+	{
+	  cerr << "could not create parent directory for "
+	       << out_report_path;
+	  is_ok = false;
+	  continue;
+	}
+
+      string abidiff = string(get_build_dir()) + "/tools/abidiff";
+      abidiff += " --no-default-suppression --verbose";
+      abidiff += " --corpus-cache-dir " + cache_dir;
+      if (s->in_suppr_path && strcmp(s->in_suppr_path, ""))
+	abidiff += " --suppressions " + source_dir_prefix + s->in_suppr_path;
+
+      cmd = abidiff + " " + in_elfv0_path + " " + in_elfv1_path
+	+ " > " + out_report_path + " 2> " + log_path;
+
+      // The first run reads the binaries and fills the cache; the
+      // second one loads the two corpora from there.
+      for (int run = 0; run < 2; ++run)
+	{
+	  int code = system(cmd.c_str());
+	  if (!WIFEXITED(code))
+	    {
+	      cerr << "could not run '" << cmd << "'\n";
+	      is_ok = false;
+	      break;
+	    }
+
+	  int num_loaded = count_corpora_loaded_from_cache(log_path);
+	  int expected_num_loaded = run == 0 ? 0 : 2;
+	  if (num_loaded != expected_num_loaded)
+	    {
+	      cerr << "for command '" << cmd << "', run " << run
+		   << ": expected " << expected_num_loaded
+		   << " corpora to be loaded from the cache, but got "
+		   << num_loaded << "\n";
+	      is_ok = false;
+	    }
+
+	  string diff_cmd = "diff -u " + ref_report_path
+	    + " " + out_report_path;
+	  if (system(diff_cmd.c_str()))
+	    is_ok = false;
+	}
+    }
+
+  return !is_ok;
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program tests the map used by the DWARF reader to associate
+/// things to DIE offsets.
+
+#include <string>
+#include <vector>
+
+#include "lib/catch.hpp"
+
+#include "abg-die-offset-map.h"
+
+using abigail::dwarf_reader::die_offset_map;
+
+TEST_CASE("DieOffsetMapFindAndInsert", "[die_offset_map]")
+{
+  die_offset_map<std::string> m;
+  CHECK(m.empty());
+  CHECK(m.find(0x2a) == m.end());
+
+  m[0x2a] = "a";
+  m[0x0b] = "b";
+  CHECK(m.size() == 2);
+  REQUIRE(m.find(0x2a) != m.end());
+  CHECK(m.find(0x2a)->second == "a");
+  CHECK(m.find(0x0b)->second == "b");
+  CHECK(m.find(0x0c) == m.end());
+
+  // Looking up an existing key doesn't add an entry.
+  m[0x2a] += "a";
+  CHECK(m.size() == 2);
+  CHECK(m.find(0x2a)->second == "aa");
+
+  const die_offset_map<std::string>& c = m;
+  CHECK(c.find(0x0b)->second == "b");
+  CHECK(c.find(0x0c) == c.end());
+
+  m.clear();
+  CHECK(m.empty());
+  CHECK(m.find(0x2a) == m.end());
+  m[0x2a] = "c";
+  CHECK(m.find(0x2a)->second == "c");
+}
+
+TEST_CASE("DieOffsetMapStableReferences", "[die_offset_map]")
+{
+  die_offset_map<Dwarf_Off> m;
+  std::vector<Dwarf_Off*> refs;
+
+  // Add enough entries for the index to grow many times, keeping a
+  // pointer to each entry as it is added.
+  const Dwarf_Off n = 100000;
+  for (Dwarf_Off o = 0; o < n; ++o)
+    {
+      Dwarf_Off key = o * 11;
+      Dwarf_Off& v = m[key];
+      v = key + 1;
+      refs.push_back(&v);
+    }
+  REQUIRE(m.size() == n);
+
+  // The entries didn't move when the index grew.
+  for (Dwarf_Off o = 0; o < n; ++o)
+    {
+      Dwarf_Off key = o * 11;
+      REQUIRE(m.find(key) != m.end());
+      CHECK(&m.find(key)->second == refs[o]);
+      CHECK(&m[key] == refs[o]);
+      CHECK(*refs[o] == key + 1);
+    }
+  CHECK(m.size() == n);
+
+  // Iterating visits the entries in the order they were added.
+  Dwarf_Off expected = 0;
+  for (die_offset_map<Dwarf_Off>::const_iterator i = m.begin();
+       i != m.end();
+       ++i, expected += 11)
+    CHECK(i->first == expected);
+  CHECK(expected == n * 11);
+}
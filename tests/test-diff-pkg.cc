@@ -355,6 +355,20 @@ static InOutSpec in_out_specs[] =
     "data/test-diff-pkg/tbb-4.1-9.20130314.fc22.x86_64--tbb-4.3-3.20141204.fc23.x86_64-report-0.txt",
     "output/test-diff-pkg/tbb-4.1-9.20130314.fc22.x86_64--tbb-4.3-3.20141204.fc23.x86_64-report-0.txt"
   },
+  // Same as above, with a memory budget so small that the binaries
+  // are compared one at a time.  The report must be the same.
+  {
+    "data/test-diff-pkg/tbb-4.1-9.20130314.fc22.x86_64.rpm",
+    "data/test-diff-pkg/tbb-4.3-3.20141204.fc23.x86_64.rpm",
+    "--no-default-suppression --memory-budget 1",
+    "",
+    "data/test-diff-pkg/tbb-debuginfo-4.1-9.20130314.fc22.x86_64.rpm",
+    "data/test-diff-pkg/tbb-debuginfo-4.3-3.20141204.fc23.x86_64.rpm",
+    "",
+    "",
+    "data/test-diff-pkg/tbb-4.1-9.20130314.fc22.x86_64--tbb-4.3-3.20141204.fc23.x86_64-report-0.txt",
+    "output/test-diff-pkg/tbb-4.1-9.20130314.fc22.x86_64--tbb-4.3-3.20141204.fc23.x86_64-memory-budget-report-0.txt"
+  },
   {
     "data/test-diff-pkg/tbb-4.1-9.20130314.fc22.x86_64.rpm",
     "data/test-diff-pkg/tbb-4.3-3.20141204.fc23.x86_64.rpm",
@@ -391,6 +405,20 @@ static InOutSpec in_out_specs[] =
     "data/test-diff-pkg/libICE-1.0.6-1.el6.x86_64.rpm--libICE-1.0.9-2.el7.x86_64.rpm-report-0.txt",
     "output/test-diff-pkg/libICE-1.0.6-1.el6.x86_64.rpm--libICE-1.0.9-2.el7.x86_64.rpm-report-0.txt"
   },
+  // Same as above, but the report about the binary is emitted as soon
+  // as it's compared, and is followed by the index of the reports.
+  {
+    "data/test-diff-pkg/libICE-1.0.6-1.el6.x86_64.rpm",
+    "data/test-diff-pkg/libICE-1.0.9-2.el7.x86_64.rpm",
+    "--no-default-suppression --stream-reports",
+    "",
+    "data/test-diff-pkg/libICE-debuginfo-1.0.6-1.el6.x86_64.rpm",
+    "data/test-diff-pkg/libICE-debuginfo-1.0.9-2.el7.x86_64.rpm",
+    "",
+    "",
+    "data/test-diff-pkg/libICE-1.0.6-1.el6.x86_64.rpm--libICE-1.0.9-2.el7.x86_64.rpm-report-1.txt",
+    "output/test-diff-pkg/libICE-1.0.6-1.el6.x86_64.rpm--libICE-1.0.9-2.el7.x86_64.rpm-report-1.txt"
+  },
   {
     "data/test-diff-pkg/gtk2-immodule-xim-2.24.22-5.el7.i686.rpm",
     "data/test-diff-pkg/gtk2-immodule-xim-2.24.28-8.el7.i686.rpm",
@@ -874,6 +902,76 @@ struct test_task : public abigail::workers::task
 /// A convenience typedef for shared
 typedef shared_ptr<test_task> test_task_sptr;
 
+#ifdef WITH_RPM
+/// Test that only the debug info files of RPM debug info packages are
+/// extracted, and not the sources that these packages carry.
+///
+/// For that, abipkgdiff is asked to keep the packages it extracted,
+/// under a cache directory of our own, which content is then
+/// inspected.
+///
+/// @return true iff the test passed.
+static bool
+test_debug_info_package_extraction()
+{
+  using abigail::tests::get_build_dir;
+
+  string src_dir = string(get_src_dir()) + "/tests/data/test-diff-pkg/";
+  string cache_dir = string(get_build_dir())
+    + "/tests/output/test-diff-pkg/debug-info-extraction-cache";
+
+  string cmd = "rm -rf " + cache_dir;
+  if (system(cmd.c_str()))
+    return false;
+
+  // The debug info packages of libICE carry sources under
+  // /usr/src/debug.
+  cmd = "XDG_CACHE_HOME=" + cache_dir + " "
+    + string(get_build_dir()) + "/tools/abipkgdiff"
+    + " --keep-tmp-files --no-default-suppression"
+    + " --d1 " + src_dir + "libICE-debuginfo-1.0.6-1.el6.x86_64.rpm"
+    + " --d2 " + src_dir + "libICE-debuginfo-1.0.9-2.el7.x86_64.rpm"
+    + " " + src_dir + "libICE-1.0.6-1.el6.x86_64.rpm"
+    + " " + src_dir + "libICE-1.0.9-2.el7.x86_64.rpm"
+    + " > /dev/null 2>&1";
+  int code = system(cmd.c_str());
+  if (!WIFEXITED(code))
+    {
+      cerr << "failed to run '" << cmd << "'\n";
+      return false;
+    }
+
+  bool is_ok = true;
+
+  // The debug info files must have been extracted ...
+  cmd = "find " + cache_dir
+    + " -path '*/usr/lib/debug/*' -name '*.debug' | grep -q .";
+  if (system(cmd.c_str()))
+    {
+      cerr << "no debug info file extracted under " << cache_dir << "\n";
+      is_ok = false;
+    }
+
+  // ... but not the sources.
+  cmd = "find " + cache_dir + " -path '*/usr/src/debug*' | grep -q .";
+  if (!system(cmd.c_str()))
+    {
+      cerr << "sources of debug info packages extracted under "
+	   << cache_dir << "\n";
+      is_ok = false;
+    }
+
+  if (is_ok)
+    {
+      cmd = "rm -rf " + cache_dir;
+      if (system(cmd.c_str()))
+	is_ok = false;
+    }
+
+  return is_ok;
+}
+#endif // WITH_RPM
+
 int
 main()
 {
@@ -925,5 +1023,10 @@ main()
 	}
     }
 
+#ifdef WITH_RPM
+    if (!test_debug_info_package_extraction())
+      is_ok = false;
+#endif // WITH_RPM
+
     return !is_ok;
 }
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program tests the pool of interned strings, notably when it
+/// is used concurrently by several threads.
+
+#include <pthread.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lib/catch.hpp"
+
+#include "abg-interned-str.h"
+
+using std::string;
+using std::vector;
+using abigail::interned_string;
+using abigail::interned_string_pool;
+
+TEST_CASE("InternedStringPoolIdentity", "[interned_string]")
+{
+  interned_string_pool pool;
+
+  CHECK(pool.has_string(""));
+  CHECK(!pool.has_string("foo"));
+  CHECK(pool.get_string("foo") == 0);
+
+  interned_string foo = pool.create_string("foo");
+  CHECK(foo == "foo");
+  CHECK(pool.has_string("foo"));
+  CHECK(pool.get_string("foo") == foo.raw()->c_str());
+
+  // Interning the same value again yields the same string.
+  interned_string foo2 = pool.create_string(string("fo") + "o");
+  CHECK(foo2.raw() == foo.raw());
+
+  // A longer string which shares a prefix is a different one.
+  interned_string foobar = pool.create_string("foobar");
+  CHECK(foobar.raw() != foo.raw());
+  CHECK(pool.get_string("foobar") == foobar.raw()->c_str());
+
+  CHECK(pool.create_string("").empty());
+}
+
+/// The number of threads that intern strings concurrently.
+static const size_t NUM_THREADS = 8;
+
+/// The number of distinct strings interned by the threads.
+static const size_t NUM_STRINGS = 20000;
+
+/// What a thread interns and what it gets back.
+struct intern_job
+{
+  interned_string_pool*	pool;
+  size_t		first;
+  vector<const string*>	raw_strings;
+};
+
+/// Build the value of the Nth string interned by the threads.  Make
+/// some of them longer than the small string buffer of std::string.
+static string
+nth_string(size_t n)
+{
+  std::ostringstream o;
+  o << "s" << n;
+  if (n % 3 == 0)
+    o << "-a-string-that-is-too-long-for-the-small-string-buffer";
+  return o.str();
+}
+
+/// Intern all the strings, starting at a different one in each
+/// thread, so that threads race to intern the same values.
+static void*
+intern_strings(void* data)
+{
+  intern_job* job = static_cast<intern_job*>(data);
+  job->raw_strings.resize(NUM_STRINGS);
+  for (size_t i = 0; i < NUM_STRINGS; ++i)
+    {
+      size_t n = (job->first + i) % NUM_STRINGS;
+      interned_string s = job->pool->create_string(nth_string(n));
+      job->raw_strings[n] = s.raw();
+    }
+  return 0;
+}
+
+TEST_CASE("InternedStringPoolConcurrentIdentity", "[interned_string]")
+{
+  interned_string_pool pool;
+  intern_job jobs[NUM_THREADS];
+  pthread_t threads[NUM_THREADS];
+
+  for (size_t t = 0; t < NUM_THREADS; ++t)
+    {
+      jobs[t].pool = &pool;
+      jobs[t].first = t * NUM_STRINGS / NUM_THREADS;
+      REQUIRE(pthread_create(&threads[t], /*attr=*/0,
+			     intern_strings, &jobs[t]) == 0);
+    }
+  for (size_t t = 0; t < NUM_THREADS; ++t)
+    REQUIRE(pthread_join(threads[t], /*retval=*/0) == 0);
+
+  // Every thread got the same string for the same value, and that
+  // string is the one the pool returns afterwards.
+  for (size_t n = 0; n < NUM_STRINGS; ++n)
+    {
+      string value = nth_string(n);
+      const char* expected = pool.get_string(value.c_str());
+      REQUIRE(expected != 0);
+      CHECK(string(expected) == value);
+      for (size_t t = 0; t < NUM_THREADS; ++t)
+	REQUIRE(jobs[t].raw_strings[n]->c_str() == expected);
+    }
+}
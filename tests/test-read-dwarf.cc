@@ -32,6 +32,7 @@ using abigail::dwarf_reader::read_corpus_from_elf;
 using abigail::dwarf_reader::read_context;
 using abigail::dwarf_reader::read_context_sptr;
 using abigail::dwarf_reader::create_read_context;
+using abigail::dwarf_reader::set_exported_interfaces_only;
 using abigail::xml_writer::SEQUENCE_TYPE_ID_STYLE;
 using abigail::xml_writer::HASH_TYPE_ID_STYLE;
 using abigail::xml_writer::create_write_context;
@@ -431,6 +432,75 @@ InOutSpec in_out_specs[] =
   {NULL, NULL, SEQUENCE_TYPE_ID_STYLE, NULL, NULL}
 };
 
+/// The tests that only read the debug info of exported functions and
+/// variables, and of the types they use, as abidw
+/// --exported-interfaces-only does.
+InOutSpec exported_interfaces_only_specs[] =
+{
+  // For these binaries, the result is the same as when reading all
+  // the debug info.
+  {
+    "data/test-read-dwarf/test0",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/test0.abi",
+    "output/test-read-dwarf/test0.exported-interfaces-only.abi"
+  },
+  {
+    "data/test-read-dwarf/test1",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/test1.abi",
+    "output/test-read-dwarf/test1.exported-interfaces-only.abi"
+  },
+  {
+    "data/test-read-dwarf/test6.so",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/test6.so.abi",
+    "output/test-read-dwarf/test6.so.exported-interfaces-only.abi"
+  },
+  {
+    "data/test-read-dwarf/test8-qualified-this-pointer.so",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/test8-qualified-this-pointer.so.abi",
+    "output/test-read-dwarf/"
+    "test8-qualified-this-pointer.so.exported-interfaces-only.abi"
+  },
+  // The DIE of the exported function stac::buggy_function is a
+  // definition which DW_AT_specification refers to a declaration DIE
+  // in the namespace stac.  When reading all the debug info, the
+  // function is built from that declaration DIE first, and its
+  // parameters have no name.  Here, the declaration DIE has no
+  // address, so it's skipped and the function is built from its
+  // definition, which names its parameter.
+  {
+    "data/test-read-dwarf/PR24378-fn-is-not-scope.o",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/PR24378-fn-is-not-scope.exported-interfaces-only.abi",
+    "output/test-read-dwarf/PR24378-fn-is-not-scope.exported-interfaces-only.abi"
+  },
+  // Likewise, the exported instance of std::copy for
+  // std::_Deque_iterator<vtkPixelExtent, ...> is built from the DIE
+  // of its out-of-line instance rather than from its declaration DIE
+  // in the namespace std.  The former refers to an abstract instance
+  // that carries DW_AT_inline, so the function is declared inline
+  // here.
+  {
+    "data/test-read-dwarf/test18-pr19037-libvtkRenderingLIC-6.1.so",
+    "",
+    SEQUENCE_TYPE_ID_STYLE,
+    "data/test-read-dwarf/"
+    "test18-pr19037-libvtkRenderingLIC-6.1.so.exported-interfaces-only.abi",
+    "output/test-read-dwarf/"
+    "test18-pr19037-libvtkRenderingLIC-6.1.so.exported-interfaces-only.abi"
+  },
+  // This should be the last entry.
+  {NULL, NULL, SEQUENCE_TYPE_ID_STYLE, NULL, NULL}
+};
+
 using abigail::suppr::suppression_sptr;
 using abigail::suppr::suppressions_type;
 using abigail::suppr::read_suppressions;
@@ -453,17 +523,20 @@ struct test_task : public abigail::workers::task
 {
   bool is_ok;
   InOutSpec spec;
+  bool exported_interfaces_only;
   string error_message;
   string out_abi_base;
   string in_elf_base;
   string in_abi_base;
 
   test_task(const InOutSpec &s,
+	    bool only_exported_interfaces,
 	    string& a_out_abi_base,
 	    string& a_in_elf_base,
 	    string& a_in_abi_base)
     : is_ok(true),
       spec(s),
+      exported_interfaces_only(only_exported_interfaces),
       out_abi_base(a_out_abi_base),
       in_elf_base(a_in_elf_base),
       in_abi_base(a_in_abi_base)
@@ -497,6 +570,7 @@ struct test_task : public abigail::workers::task
     ABG_ASSERT(ctxt);
     if (!in_suppr_spec_path.empty())
       set_suppressions(*ctxt, in_suppr_spec_path);
+    set_exported_interfaces_only(*ctxt, exported_interfaces_only);
 
     abigail::corpus_sptr corp = read_corpus_from_elf(*ctxt, status);
     // if there is no output and no input, assume that we do not care about the
@@ -541,7 +615,10 @@ struct test_task : public abigail::workers::task
     of.close();
 
     string abidw = string(get_build_dir()) + "/tools/abidw";
-    string cmd = abidw + " --abidiff " + in_elf_path;
+    string cmd = abidw + " --abidiff ";
+    if (exported_interfaces_only)
+      cmd += "--exported-interfaces-only ";
+    cmd += in_elf_path;
     if (system(cmd.c_str()))
       {
 	error_message = string("ABIs differ:\n")
@@ -583,7 +660,9 @@ main(int argc, char *argv[])
   /// processor of the machine this code runs on.  But if
   /// --no-parallel was provided then the number of worker threads
   /// equals 1.
-  const size_t num_tests = sizeof(in_out_specs) / sizeof (InOutSpec) - 1;
+  const size_t num_tests =
+    sizeof(in_out_specs) / sizeof (InOutSpec) - 1
+    + sizeof(exported_interfaces_only_specs) / sizeof (InOutSpec) - 1;
   size_t num_workers = (no_parallel
 			? 1
 			: std::min(abigail::workers::get_number_of_threads(),
@@ -597,7 +676,17 @@ main(int argc, char *argv[])
 
   for (InOutSpec *s = in_out_specs; s->in_elf_path; ++s)
     {
-      test_task_sptr t(new test_task(*s, out_abi_base,
+      test_task_sptr t(new test_task(*s, /*exported_interfaces_only=*/false,
+				     out_abi_base,
+				     in_elf_base,
+				     in_abi_base));
+      ABG_ASSERT(task_queue.schedule_task(t));
+    }
+
+  for (InOutSpec *s = exported_interfaces_only_specs; s->in_elf_path; ++s)
+    {
+      test_task_sptr t(new test_task(*s, /*exported_interfaces_only=*/true,
+				     out_abi_base,
 				     in_elf_base,
 				     in_abi_base));
       ABG_ASSERT(task_queue.schedule_task(t));
@@ -341,6 +341,31 @@ struct test_task : public abigail::workers::task
     diff_cmd = cmd;
     if (system(cmd.c_str()))
       is_ok = false;
+
+    // ABI corpora must also survive a round trip through the native
+    // binary format.
+    if (is_ok
+	&& t == abigail::tools_utils::FILE_TYPE_XML_CORPUS
+	&& in_suppr_spec_path.empty())
+      {
+	string bin_path = out_path + ".bin";
+	string bin_out_path = bin_path + ".xml";
+	cmd = abilint + " --native-binary " + in_path + " > " + bin_path
+	  + " && " + string(get_build_dir()) + "/tools/abilint "
+	  + bin_path + " > " + bin_out_path;
+	if (system(cmd.c_str()))
+	  {
+	    error_message =
+	      "native binary file doesn't pass abilint: " + bin_path + "\n";
+	    is_ok = false;
+	    return;
+	  }
+
+	cmd = "diff -u " + ref_out_path + " " + bin_out_path;
+	diff_cmd = cmd;
+	if (system(cmd.c_str()))
+	  is_ok = false;
+      }
   }
 };// end struct test_task
 
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program tests the regex wrappers of libabigail.
+///
+/// regex::match rejects or accepts some strings without calling
+/// regexec, depending on the form of the regex.  So each test checks
+/// that regex::match agrees with regexec on the same regex, for
+/// strings that the shortcuts could get wrong.
+
+#include <regex.h>
+
+#include <string>
+#include <vector>
+
+#include "lib/catch.hpp"
+
+#include "abg-regex.h"
+
+using std::string;
+using std::vector;
+
+/// Check that regex::match on a regex built by regex::compile gives
+/// the same result as regexec, for a set of strings.
+///
+/// @param pattern the regex to consider.
+///
+/// @param matching the strings that @p pattern must match.
+///
+/// @param non_matching the strings that @p pattern must not match.
+static void
+check_regex(const string& pattern,
+	    const vector<string>& matching,
+	    const vector<string>& non_matching)
+{
+  INFO("regex: " << pattern);
+  abigail::regex::regex_t_sptr r = abigail::regex::compile(pattern);
+  REQUIRE(r);
+
+  regex_t reference;
+  REQUIRE(regcomp(&reference, pattern.c_str(), REG_EXTENDED) == 0);
+
+  for (vector<string>::const_iterator i = matching.begin();
+       i != matching.end();
+       ++i)
+    {
+      INFO("string: " << *i);
+      CHECK(!regexec(&reference, i->c_str(), 0, NULL, 0));
+      CHECK(abigail::regex::match(r, *i));
+    }
+
+  for (vector<string>::const_iterator i = non_matching.begin();
+       i != non_matching.end();
+       ++i)
+    {
+      INFO("string: " << *i);
+      CHECK(regexec(&reference, i->c_str(), 0, NULL, 0));
+      CHECK(!abigail::regex::match(r, *i));
+    }
+
+  regfree(&reference);
+}
+
+TEST_CASE("AnchoredLiteralPrefix", "[regex]")
+{
+  check_regex("^foo",
+	      {"foo", "foobar"},
+	      {"", "fo", "barfoo", "Foo"});
+  check_regex("^foo.*bar",
+	      {"foobar", "foo_and_bar", "foobarbaz"},
+	      {"fobar", "barfoobar"});
+  check_regex("^_ZN3foo",
+	      {"_ZN3foo3barEv"},
+	      {"_ZN3bar3fooEv", "foo"});
+}
+
+TEST_CASE("EscapedMetacharactersInPrefix", "[regex]")
+{
+  check_regex("^foo\\.h$",
+	      {"foo.h"},
+	      {"fooXh", "foo.hh"});
+  check_regex("^a\\+\\+b",
+	      {"a++b", "a++bc"},
+	      {"aab", "a+b"});
+  check_regex("^\\(anonymous\\)",
+	      {"(anonymous)", "(anonymous) struct"},
+	      {"anonymous", "(anon"});
+  check_regex("^path/to/\\[x\\]\\\\y",
+	      {"path/to/[x]\\y", "path/to/[x]\\yz"},
+	      {"path/to/x\\y", "path/to/[x]y"});
+}
+
+TEST_CASE("NoPrefixFastPath", "[regex]")
+{
+  // Not anchored.
+  check_regex("foo",
+	      {"foo", "barfoo"},
+	      {"bar"});
+  // The last character of the literal is optional or repeated.
+  check_regex("^ab?c",
+	      {"ac", "abc"},
+	      {"abbc", "bc"});
+  check_regex("^ab*c",
+	      {"ac", "abbbc"},
+	      {"adc"});
+  check_regex("^ab{0,2}c",
+	      {"ac", "abbc"},
+	      {"abbbc"});
+  // An alternation lifts the anchor of the other branches.
+  check_regex("^foo|bar",
+	      {"foo", "xbar"},
+	      {"xfoo"});
+  // Escape sequences that are not escaped metacharacters.
+  check_regex("^a\\wc",
+	      {"abc", "a_c"},
+	      {"a-c"});
+  // Bracket expressions and wildcards end the prefix.
+  check_regex("^[ab]c",
+	      {"ac", "bc"},
+	      {"cc"});
+  check_regex("^.oo",
+	      {"foo", "boo"},
+	      {"fo"});
+  check_regex("^(foo)*bar",
+	      {"bar", "foofoobar"},
+	      {"fobar"});
+}
+
+TEST_CASE("LiteralAlternatives", "[regex]")
+{
+  check_regex("^foo$",
+	      {"foo"},
+	      {"", "fo", "foobar", "xfoo"});
+  check_regex("^(foo|bar|baz)$",
+	      {"foo", "bar", "baz"},
+	      {"", "ba", "foobar", "foo|bar", "(foo)"});
+  // Escaped metacharacters are literal characters of the
+  // alternatives.
+  check_regex("^(a\\.b|c\\|d|e\\(f\\)|g\\\\h)$",
+	      {"a.b", "c|d", "e(f)", "g\\h"},
+	      {"axb", "c", "d", "ef", "g\\\\h"});
+  // What generate_from_strings emits.
+  vector<string> names = {"foo.bar", "a+b", "[x]", "baz"};
+  check_regex(abigail::regex::generate_from_strings(names),
+	      names,
+	      {"fooXbar", "aab", "x", "ba", "bazz"});
+}
+
+TEST_CASE("NoLiteralAlternativesFastPath", "[regex]")
+{
+  // Empty alternatives.
+  check_regex("^(foo||bar)$",
+	      {"foo", "", "bar"},
+	      {"foobar"});
+  check_regex("^(|foo)$",
+	      {"", "foo"},
+	      {"f"});
+  // Nested groups.
+  check_regex("^((a|b)|c)$",
+	      {"a", "b", "c"},
+	      {"ab", "(a"});
+  check_regex("^(a(b|c))$",
+	      {"ab", "ac"},
+	      {"a", "abc"});
+  // Something follows the group.
+  check_regex("^(a|b)c$",
+	      {"ac", "bc"},
+	      {"a", "b", "c", "abc"});
+  // No end anchor.
+  check_regex("^(a|b)",
+	      {"a", "b", "ax", "bx"},
+	      {"c", "xa"});
+  check_regex("^foo",
+	      {"foo", "foox"},
+	      {"fo"});
+  // Unescaped metacharacters in an alternative.
+  check_regex("^(a.b|c)$",
+	      {"axb", "c"},
+	      {"ab", "cc"});
+  check_regex("^(a+|b)$",
+	      {"a", "aaa", "b"},
+	      {"ab"});
+}
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program tests that caching the verdicts of suppression
+/// specifications against diff nodes in the diff context doesn't
+/// change the verdicts of diff::is_suppressed, including when the
+/// suppression specifications of the context are changed after some
+/// verdicts have been cached.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "abg-comparison.h"
+#include "abg-corpus.h"
+#include "abg-dwarf-reader.h"
+#include "abg-suppression.h"
+#include "lib/catch.hpp"
+#include "test-utils.h"
+
+using std::string;
+using std::vector;
+using namespace abigail;
+using namespace abigail::comparison;
+using abigail::suppr::suppressions_type;
+
+/// A visitor that collects all the nodes of a diff tree.
+struct node_collector : public diff_node_visitor
+{
+  vector<diff*> nodes;
+
+  virtual bool
+  visit(diff* d, bool pre)
+  {
+    if (pre)
+      nodes.push_back(d);
+    return true;
+  }
+};
+
+/// Collect all the nodes of a corpus diff tree.
+///
+/// @param d the corpus diff to consider.
+///
+/// @return the nodes of @p d, in traversal order.
+static vector<diff*>
+collect_nodes(const corpus_diff_sptr& d)
+{
+  node_collector v;
+  bool s = d->context()->visiting_a_node_twice_is_forbidden();
+  d->context()->forbid_visiting_a_node_twice(false);
+  d->traverse(v);
+  d->context()->forbid_visiting_a_node_twice(s);
+  return v.nodes;
+}
+
+/// Check that the verdicts of diff::is_suppressed, which come from
+/// the cache of the diff context when they have been computed
+/// already, are the verdicts of the current suppression
+/// specifications of the diff context.
+///
+/// @param nodes the diff nodes to check.
+///
+/// @param ctxt the diff context of @p nodes.
+///
+/// @return the number of nodes of @p nodes that are suppressed.
+static size_t
+check_verdicts(const vector<diff*>& nodes, const diff_context_sptr& ctxt)
+{
+  const suppressions_type& supprs =
+    static_cast<const diff_context&>(*ctxt).suppressions();
+  size_t num_suppressed = 0;
+  for (vector<diff*>::const_iterator n = nodes.begin();
+       n != nodes.end();
+       ++n)
+    {
+      bool expected = false, expected_private_type = false;
+      for (suppressions_type::const_iterator s = supprs.begin();
+	   s != supprs.end();
+	   ++s)
+	if ((*s)->suppresses_diff(*n))
+	  {
+	    expected = true;
+	    expected_private_type = suppr::is_private_type_suppr_spec(*s);
+	    break;
+	  }
+
+      INFO("diff node: " << (*n)->get_pretty_representation());
+      bool private_type = false;
+      CHECK((*n)->is_suppressed(private_type) == expected);
+      CHECK(private_type == expected_private_type);
+      if (expected)
+	++num_suppressed;
+    }
+  return num_suppressed;
+}
+
+/// Parse suppression specifications.
+///
+/// @param text the text of the suppression specifications.
+///
+/// @return the suppression specifications.
+static suppressions_type
+parse_suppressions(const string& text)
+{
+  std::istringstream input(text);
+  suppressions_type supprs;
+  suppr::read_suppressions(input, supprs);
+  REQUIRE(!supprs.empty());
+  return supprs;
+}
+
+/// Read the corpus of an ELF binary of the test data.
+///
+/// @param path the path of the binary, relative to tests/data.
+///
+/// @param env the environment to read the corpus in.
+///
+/// @return the corpus read.
+static corpus_sptr
+read_corpus(const string& path, ir::environment& env)
+{
+  string elf_path =
+    string(abigail::tests::get_src_dir()) + "/tests/data/" + path;
+  vector<char**> debug_info_root_paths;
+  dwarf_reader::status status = dwarf_reader::STATUS_UNKNOWN;
+  corpus_sptr c =
+    dwarf_reader::read_corpus_from_elf(elf_path, debug_info_root_paths,
+				       &env, /*load_all_types=*/false, status);
+  REQUIRE(c);
+  REQUIRE((status & dwarf_reader::STATUS_OK));
+  return c;
+}
+
+// The changed functions of the binaries are
+//
+//   int foo(S1*);
+//   int bar(S2*);
+//   int baz(S3*);
+static const char* v0_path = "test-diff-dwarf/libtest40-v0.so";
+static const char* v1_path = "test-diff-dwarf/libtest40-v1.so";
+
+TEST_CASE("CachedVerdictsMatchSuppressions", "[suppression_verdicts]")
+{
+  ir::environment env;
+  corpus_sptr c0 = read_corpus(v0_path, env);
+  corpus_sptr c1 = read_corpus(v1_path, env);
+
+  const char* specs[] =
+  {
+    "[suppress_type]\n  name = S2\n",
+    "[suppress_type]\n  name_regexp = ^S[13]$\n",
+    "[suppress_type]\n  name = S1\n  has_data_member_inserted_at = 0\n",
+    "[suppress_function]\n  name = bar\n",
+    "[suppress_type]\n  name = S2\n"
+    "[suppress_type]\n  name = S3\n"
+  };
+
+  for (size_t i = 0; i < sizeof(specs) / sizeof(specs[0]); ++i)
+    {
+      INFO("suppressions: " << specs[i]);
+      diff_context_sptr ctxt(new diff_context);
+      ctxt->add_suppressions(parse_suppressions(specs[i]));
+      corpus_diff_sptr d = compute_diff(c0, c1, ctxt);
+      vector<diff*> nodes = collect_nodes(d);
+      REQUIRE(!nodes.empty());
+
+      // The first round computes the verdicts, the second one gets
+      // them from the cache.
+      size_t num_suppressed = check_verdicts(nodes, ctxt);
+      CHECK(ctxt->num_suppression_verdict_cache_misses() > 0);
+      size_t num_hits = ctxt->num_suppression_verdict_cache_hits();
+      CHECK(check_verdicts(nodes, ctxt) == num_suppressed);
+      CHECK(ctxt->num_suppression_verdict_cache_hits()
+	    >= num_hits + nodes.size());
+    }
+}
+
+TEST_CASE("CachedVerdictsFollowSuppressionChanges", "[suppression_verdicts]")
+{
+  ir::environment env;
+  corpus_sptr c0 = read_corpus(v0_path, env);
+  corpus_sptr c1 = read_corpus(v1_path, env);
+
+  diff_context_sptr ctxt(new diff_context);
+  ctxt->add_suppressions(parse_suppressions("[suppress_type]\n"
+					    "  name = S2\n"));
+  corpus_diff_sptr d = compute_diff(c0, c1, ctxt);
+  vector<diff*> nodes = collect_nodes(d);
+  size_t num_suppressed_s2 = check_verdicts(nodes, ctxt);
+  CHECK(num_suppressed_s2 > 0);
+
+  // Replace the suppression through the vector returned by
+  // diff_context::suppressions.  The number of suppressions doesn't
+  // change.
+  ctxt->suppressions()[0] =
+    parse_suppressions("[suppress_type]\n  name = S3\n")[0];
+  size_t num_suppressed_s3 = check_verdicts(nodes, ctxt);
+  CHECK(num_suppressed_s3 > 0);
+
+  // Remove all the suppressions through that vector.
+  ctxt->suppressions().clear();
+  CHECK(check_verdicts(nodes, ctxt) == 0);
+
+  // Add suppressions through that vector and through
+  // diff_context::add_suppression.
+  ctxt->suppressions().push_back
+    (parse_suppressions("[suppress_type]\n  name = S2\n")[0]);
+  CHECK(check_verdicts(nodes, ctxt) == num_suppressed_s2);
+  ctxt->add_suppression
+    (parse_suppressions("[suppress_type]\n  name = S3\n")[0]);
+  CHECK(check_verdicts(nodes, ctxt)
+	== num_suppressed_s2 + num_suppressed_s3);
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// -*- Mode: C++ -*-
+//
+// Copyright (C) 2020 Red Hat, Inc.
+
+/// @file
+///
+/// This program tests that memoizing the results of type comparisons
+/// during type canonicalization doesn't change the outcome of type
+/// canonicalization.
+
+#include <string>
+
+#include "lib/catch.hpp"
+
+#include "abg-ir.h"
+
+using std::string;
+using namespace abigail::ir;
+
+/// The types built by build_types.
+struct test_types
+{
+  translation_unit_sptr	tu;
+  class_decl_sptr	s;
+  class_decl_sptr	t;
+};
+
+/// Build, in a new translation unit, the types
+///
+///   struct S {<member_type> a; S* next;};
+///   struct T {S s0; S s1; S* p;};
+///
+/// S is recursive, so comparing two instances of S relies on the
+/// assumption made to break comparison cycles.  T uses S several
+/// times, so comparing two instances of T compares the same pair of
+/// instances of S several times.
+///
+/// @param env the environment to build the types in.
+///
+/// @param path the path of the translation unit to create.
+///
+/// @param member_type the name of the type of S::a.  It must be
+/// either "int" or "char".
+///
+/// @return the types built.
+static test_types
+build_types(environment& env, const string& path, const string& member_type)
+{
+  test_types r;
+  r.tu.reset(new translation_unit(&env, path, 64));
+  scope_decl* scope = r.tu->get_global_scope().get();
+  location loc;
+
+  type_decl_sptr int_type(new type_decl(&env, member_type,
+					member_type == "int" ? 32 : 8,
+					member_type == "int" ? 32 : 8,
+					loc));
+  add_decl_to_scope(int_type, scope);
+
+  r.s.reset(new class_decl(&env, "S", 128, 64, /*is_struct=*/true,
+			   loc, decl_base::VISIBILITY_DEFAULT));
+  add_decl_to_scope(r.s, scope);
+  pointer_type_def_sptr s_ptr(new pointer_type_def(r.s, 64, 64, loc));
+  add_decl_to_scope(s_ptr, scope);
+  r.s->add_data_member(var_decl_sptr(new var_decl("a", int_type, loc, "")),
+		       public_access, /*is_laid_out=*/true,
+		       /*is_static=*/false, 0);
+  r.s->add_data_member(var_decl_sptr(new var_decl("next", s_ptr, loc, "")),
+		       public_access, /*is_laid_out=*/true,
+		       /*is_static=*/false, 64);
+
+  r.t.reset(new class_decl(&env, "T", 320, 64, /*is_struct=*/true,
+			   loc, decl_base::VISIBILITY_DEFAULT));
+  add_decl_to_scope(r.t, scope);
+  r.t->add_data_member(var_decl_sptr(new var_decl("s0", r.s, loc, "")),
+		       public_access, /*is_laid_out=*/true,
+		       /*is_static=*/false, 0);
+  r.t->add_data_member(var_decl_sptr(new var_decl("s1", r.s, loc, "")),
+		       public_access, /*is_laid_out=*/true,
+		       /*is_static=*/false, 128);
+  r.t->add_data_member(var_decl_sptr(new var_decl("p", s_ptr, loc, "")),
+		       public_access, /*is_laid_out=*/true,
+		       /*is_static=*/false, 256);
+
+  return r;
+}
+
+TEST_CASE("MemoizedComparisonsKeepCanonicalTypes", "[type_comparison_cache]")
+{
+  environment env;
+
+  // Two identical sets of types, and a set of types that only
+  // differs from them deep inside S.
+  test_types t0 = build_types(env, "t0.c", "int");
+  test_types t1 = build_types(env, "t1.c", "int");
+  test_types t2 = build_types(env, "t2.c", "char");
+
+  // Canonicalize T before S, so that the comparisons of the
+  // instances of T compare instances of S structurally.
+  test_types* sets[] = {&t0, &t1, &t2};
+  for (size_t i = 0; i < 3; ++i)
+    canonicalize(sets[i]->t);
+  for (size_t i = 0; i < 3; ++i)
+    canonicalize(sets[i]->s);
+
+  CHECK(t0.t->get_canonical_type() == t1.t->get_canonical_type());
+  CHECK(t0.s->get_canonical_type() == t1.s->get_canonical_type());
+  CHECK(t0.t->get_canonical_type() != t2.t->get_canonical_type());
+  CHECK(t0.s->get_canonical_type() != t2.s->get_canonical_type());
+
+  // The cache was looked up during canonicalization.
+  size_t num_lookups = 0, num_hits = 0;
+  env.get_type_comparison_cache_stats(num_lookups, num_hits);
+  CHECK(num_lookups > 0);
+  CHECK(num_hits <= num_lookups);
+
+  // Comparing types that are not canonicalized is done structurally,
+  // without the cache, which is only enabled during canonicalization.
+  // The results must be the same as those of canonicalization.
+  test_types fresh_int = build_types(env, "fresh-int.c", "int");
+  test_types fresh_char = build_types(env, "fresh-char.c", "char");
+  for (size_t i = 0; i < 3; ++i)
+    {
+      bool same_as_int =
+	sets[i]->t->get_canonical_type() == t0.t->get_canonical_type();
+      CHECK((*fresh_int.t == *sets[i]->t) == same_as_int);
+      CHECK((*fresh_char.t == *sets[i]->t) == !same_as_int);
+      CHECK((*fresh_int.s == *sets[i]->s) == same_as_int);
+      CHECK((*fresh_char.s == *sets[i]->s) == !same_as_int);
+    }
+
+  // And the cache was left empty and disabled: these comparisons
+  // didn't look it up.
+  size_t num_lookups_after = 0;
+  env.get_type_comparison_cache_stats(num_lookups_after, num_hits);
+  CHECK(num_lookups_after == num_lookups);
+}
@@ -68,6 +68,7 @@ struct options
   vector<string>        header_files1;
   vector<string>	headers_dirs2;
   vector<string>        header_files2;
+  string		corpus_cache_dir;
   bool			drop_private_types;
   bool			linux_kernel_mode;
   bool			no_default_supprs;
@@ -189,6 +190,8 @@ display_usage(const string& prog_name, ostream& out)
     << " --no-architecture  do not take architecture in account\n"
     << " --no-corpus-path  do not take the path to the corpora into account\n"
     << " --fail-no-debug-info  bail out if no debug info was found\n"
+    << " --corpus-cache-dir <path>  cache the corpora read from binaries "
+    "in a directory\n"
     << " --leaf-changes-only|-l  only show leaf changes, "
     "so no change impact analysis (implies --redundant)\n"
     << " --deleted-fns  display deleted public functions\n"
@@ -298,6 +301,18 @@ parse_command_line(int argc, char* argv[], options& opts)
 	    (abigail::tools_utils::make_path_absolute_to_be_freed(argv[j]));
 	  ++i;
 	}
+      else if (!strcmp(argv[i], "--corpus-cache-dir"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  opts.corpus_cache_dir = argv[j];
+	  ++i;
+	}
       else if (!strcmp(argv[i], "--headers-dir1")
 	       || !strcmp(argv[i], "--hd1"))
 	{
@@ -1032,6 +1047,21 @@ emit_incompatible_format_version_error_message(const string& file_path1,
     << "'" << file_path2 << "'\n" ;
 }
 
+/// Emit statistics about the comparison performed using a given diff
+/// context.
+///
+/// @param ctxt the diff context to consider.
+///
+/// @param prog_name the name of the current program.
+static void
+emit_diff_stats(const diff_context& ctxt, const string& prog_name)
+{
+  emit_prefix(prog_name, cerr)
+    << "suppression verdict cache: "
+    << ctxt.num_suppression_verdict_cache_hits() << " hits, "
+    << ctxt.num_suppression_verdict_cache_misses() << " misses\n";
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -1148,6 +1178,8 @@ main(int argc, char* argv[])
 	    abigail::dwarf_reader::set_show_stats(*ctxt, opts.show_stats);
 	    set_suppressions(*ctxt, opts);
 	    abigail::dwarf_reader::set_do_log(*ctxt, opts.do_log);
+	    abigail::dwarf_reader::set_corpus_cache_directory
+	      (*ctxt, opts.corpus_cache_dir);
 	    c1 = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, c1_status);
 	    if (!c1
 		|| (opts.fail_no_debug_info
@@ -1185,6 +1217,34 @@ main(int argc, char* argv[])
 				  argv[0], opts);
 	  }
 	  break;
+	case abigail::tools_utils::FILE_TYPE_BINARY_CORPUS:
+	  {
+	    abigail::xml_reader::read_context_sptr ctxt =
+	      abigail::xml_reader::create_native_binary_read_context
+	      (opts.file1, env.get());
+	    assert(ctxt);
+	    set_suppressions(*ctxt, opts);
+	    set_native_xml_reader_options(*ctxt, opts);
+	    c1 = abigail::xml_reader::read_corpus_from_input(*ctxt);
+	    if (!c1)
+	      return handle_error(c1_status, /*ctxt=*/0,
+				  argv[0], opts);
+	  }
+	  break;
+	case abigail::tools_utils::FILE_TYPE_BINARY_CORPUS_GROUP:
+	  {
+	    abigail::xml_reader::read_context_sptr ctxt =
+	      abigail::xml_reader::create_native_binary_read_context
+	      (opts.file1, env.get());
+	    assert(ctxt);
+	    set_suppressions(*ctxt, opts);
+	    set_native_xml_reader_options(*ctxt, opts);
+	    g1 = abigail::xml_reader::read_corpus_group_from_input(*ctxt);
+	    if (!g1)
+	      return handle_error(c1_status, /*ctxt=*/0,
+				  argv[0], opts);
+	  }
+	  break;
 	case abigail::tools_utils::FILE_TYPE_RPM:
 	case abigail::tools_utils::FILE_TYPE_SRPM:
 	case abigail::tools_utils::FILE_TYPE_DEB:
@@ -1216,6 +1276,8 @@ main(int argc, char* argv[])
 	    abigail::dwarf_reader::set_show_stats(*ctxt, opts.show_stats);
 	    abigail::dwarf_reader::set_do_log(*ctxt, opts.do_log);
 	    set_suppressions(*ctxt, opts);
+	    abigail::dwarf_reader::set_corpus_cache_directory
+	      (*ctxt, opts.corpus_cache_dir);
 
 	    c2 = abigail::dwarf_reader::read_corpus_from_elf(*ctxt, c2_status);
 	    if (!c2
@@ -1253,6 +1315,32 @@ main(int argc, char* argv[])
 	      return handle_error(c2_status, /*ctxt=*/0, argv[0], opts);
 	  }
 	  break;
+	case abigail::tools_utils::FILE_TYPE_BINARY_CORPUS:
+	  {
+	    abigail::xml_reader::read_context_sptr ctxt =
+	      abigail::xml_reader::create_native_binary_read_context
+	      (opts.file2, env.get());
+	    assert(ctxt);
+	    set_suppressions(*ctxt, opts);
+	    set_native_xml_reader_options(*ctxt, opts);
+	    c2 = abigail::xml_reader::read_corpus_from_input(*ctxt);
+	    if (!c2)
+	      return handle_error(c2_status, /*ctxt=*/0, argv[0], opts);
+	  }
+	  break;
+	case abigail::tools_utils::FILE_TYPE_BINARY_CORPUS_GROUP:
+	  {
+	    abigail::xml_reader::read_context_sptr ctxt =
+	      abigail::xml_reader::create_native_binary_read_context
+	      (opts.file2, env.get());
+	    assert(ctxt);
+	    set_suppressions(*ctxt, opts);
+	    set_native_xml_reader_options(*ctxt, opts);
+	    g2 = abigail::xml_reader::read_corpus_group_from_input(*ctxt);
+	    if (!g2)
+	      return handle_error(c2_status, /*ctxt=*/0, argv[0], opts);
+	  }
+	  break;
 	case abigail::tools_utils::FILE_TYPE_RPM:
 	case abigail::tools_utils::FILE_TYPE_SRPM:
 	case abigail::tools_utils::FILE_TYPE_DEB:
@@ -1321,6 +1409,9 @@ main(int argc, char* argv[])
 
 	  if (diff->has_changes())
 	    diff->report(cout);
+
+	  if (opts.show_stats)
+	    emit_diff_stats(*ctxt, argv[0]);
 	}
       else if (g1)
 	{
@@ -1351,6 +1442,8 @@ main(int argc, char* argv[])
 	  if (diff->has_changes())
 	    diff->report(cout);
 
+	  if (opts.show_stats)
+	    emit_diff_stats(*ctxt, argv[0]);
 	}
       else
 	status = abigail::tools_utils::ABIDIFF_ERROR;
@@ -60,8 +60,10 @@ using abigail::xml_writer::HASH_TYPE_ID_STYLE;
 using abigail::xml_writer::create_write_context;
 using abigail::xml_writer::type_id_style_kind;
 using abigail::xml_writer::write_context_sptr;
+using abigail::xml_writer::set_binary_output;
 using abigail::xml_writer::write_corpus;
 using abigail::xml_reader::read_corpus_from_native_xml_file;
+using abigail::xml_reader::read_corpus_from_native_binary_file;
 using abigail::dwarf_reader::read_context;
 using abigail::dwarf_reader::read_context_sptr;
 using abigail::dwarf_reader::read_corpus_from_elf;
@@ -103,6 +105,8 @@ struct options
   bool			drop_private_types;
   bool			drop_undefined_syms;
   bool			merge_translation_units;
+  bool			exported_interfaces_only;
+  bool			binary_output;
   type_id_style_kind	type_id_style;
 
   options()
@@ -128,6 +132,8 @@ struct options
       drop_private_types(false),
       drop_undefined_syms(false),
       merge_translation_units(false),
+      exported_interfaces_only(false),
+      binary_output(false),
       type_id_style(SEQUENCE_TYPE_ID_STYLE)
   {}
 
@@ -162,6 +168,8 @@ display_usage(const string& prog_name, ostream& out)
     << "  --short-locs  only print filenames rather than paths\n"
     << "  --drop-private-types  drop private types from representation\n"
     << "  --drop-undefined-syms  drop undefined symbols from representation\n"
+    << "  --exported-interfaces-only  only read the debug info of exported "
+    "functions and variables and of the types they use\n"
     << "  --merge-translation-units  merge translation units for same language\n"
     << "  --no-comp-dir-path  do not show compilation path information\n"
     << "  --no-elf-needed  do not show the DT_NEEDED information\n"
@@ -170,6 +178,8 @@ display_usage(const string& prog_name, ostream& out)
     << "  --no-parameter-names  do not show names of function parameters\n"
     << "  --type-id-style <sequence|hash>  type id style (sequence(default): "
        "\"type-id-\" + number; hash: hex-digits)\n"
+    << "  --native-binary  emit the ABI in the native binary corpus format "
+    "rather than in abixml (experimental)\n"
     << "  --check-alternate-debug-info <elf-path>  check alternate debug info "
     "of <elf-path>\n"
     << "  --check-alternate-debug-info-base-name <elf-path>  check alternate "
@@ -308,6 +318,8 @@ parse_command_line(int argc, char* argv[], options& opts)
           else
             return false;
         }
+      else if (!strcmp(argv[i], "--native-binary"))
+	opts.binary_output = true;
       else if (!strcmp(argv[i], "--check-alternate-debug-info")
 	       || !strcmp(argv[i], "--check-alternate-debug-info-base-name"))
 	{
@@ -327,6 +339,8 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.drop_private_types = true;
       else if (!strcmp(argv[i], "--drop-undefined-syms"))
 	opts.drop_undefined_syms = true;
+      else if (!strcmp(argv[i], "--exported-interfaces-only"))
+	opts.exported_interfaces_only = true;
       else if (!strcmp(argv[i], "--merge-translation-units"))
 	opts.merge_translation_units = true;
       else if (!strcmp(argv[i], "--no-linux-kernel-mode"))
@@ -540,6 +554,7 @@ load_corpus_and_write_abixml(char* argv[],
       const write_context_sptr& write_ctxt
 	  = create_write_context(corp->get_environment(), cout);
       set_common_options(*write_ctxt, opts);
+      set_binary_output(*write_ctxt, opts.binary_output);
       t.stop();
 
       if (opts.do_log)
@@ -557,9 +572,11 @@ load_corpus_and_write_abixml(char* argv[],
 	  write_corpus(*write_ctxt, corp, 0);
 	  tmp_file->get_stream().flush();
 	  t.start();
-	  corpus_sptr corp2 =
-	    read_corpus_from_native_xml_file(tmp_file->get_path(),
-					     env.get());
+	  corpus_sptr corp2 = opts.binary_output
+	    ? read_corpus_from_native_binary_file(tmp_file->get_path(),
+						  env.get())
+	    : read_corpus_from_native_xml_file(tmp_file->get_path(),
+					       env.get());
 	  t.stop();
 	  if (opts.do_log)
 	    emit_prefix(argv[0], cerr)
@@ -693,6 +710,7 @@ load_kernel_corpus_group_and_write_abixml(char* argv[],
       const xml_writer::write_context_sptr& ctxt
 	  = xml_writer::create_write_context(group->get_environment(), cout);
       set_common_options(*ctxt, opts);
+      set_binary_output(*ctxt, opts.binary_output);
 
       if (!opts.out_file_path.empty())
 	{
@@ -820,6 +838,8 @@ main(int argc, char* argv[])
       set_show_stats(ctxt, opts.show_stats);
       set_suppressions(ctxt, opts);
       abigail::dwarf_reader::set_do_log(ctxt, opts.do_log);
+      abigail::dwarf_reader::set_exported_interfaces_only
+	(ctxt, opts.exported_interfaces_only);
 
       if (opts.check_alt_debug_info_path)
 	{
@@ -57,6 +57,7 @@ using abigail::xml_writer::write_context_sptr;
 using abigail::xml_writer::create_write_context;
 using abigail::xml_writer::write_corpus;
 using abigail::xml_writer::write_corpus_to_archive;
+using abigail::xml_writer::set_binary_output;
 
 struct options
 {
@@ -67,6 +68,7 @@ struct options
   bool				read_tu;
   bool				diff;
   bool				noout;
+  bool				binary_output;
   std::shared_ptr<char>	di_root_path;
   vector<string>		suppression_paths;
   string			headers_dir;
@@ -77,7 +79,8 @@ struct options
       read_from_stdin(false),
       read_tu(false),
       diff(false),
-      noout(false)
+      noout(false),
+      binary_output(false)
   {}
 };//end struct options;
 
@@ -98,6 +101,8 @@ display_usage(const string& prog_name, ostream& out)
     << "  --diff  for xml inputs, perform a text diff between "
     "the input and the memory model saved back to disk\n"
     << "  --noout  do not display anything on stdout\n"
+    << "  --native-binary  write ABI corpora in the native binary "
+    "format (experimental)\n"
     << "  --stdin|--  read abi-file content from stdin\n"
     << "  --tu  expect a single translation unit file\n";
 }
@@ -177,6 +182,8 @@ parse_command_line(int argc, char* argv[], options& opts)
 	  opts.diff = true;
 	else if (!strcmp(argv[i], "--noout"))
 	  opts.noout = true;
+	else if (!strcmp(argv[i], "--native-binary"))
+	  opts.binary_output = true;
 	else
 	  {
 	    if (strlen(argv[i]) >= 2 && argv[i][0] == '-' && argv[i][1] == '-')
@@ -367,6 +374,26 @@ main(int argc, char* argv[])
 	    group = read_corpus_group_from_input(*ctxt);
 	  }
 	  break;
+	case abigail::tools_utils::FILE_TYPE_BINARY_CORPUS:
+	  {
+	    abigail::xml_reader::read_context_sptr ctxt =
+	      abigail::xml_reader::create_native_binary_read_context
+	      (opts.file_path, env.get());
+	    assert(ctxt);
+	    set_suppressions(*ctxt, opts);
+	    corp = read_corpus_from_input(*ctxt);
+	  }
+	  break;
+	case abigail::tools_utils::FILE_TYPE_BINARY_CORPUS_GROUP:
+	  {
+	    abigail::xml_reader::read_context_sptr ctxt =
+	      abigail::xml_reader::create_native_binary_read_context
+	      (opts.file_path, env.get());
+	    assert(ctxt);
+	    set_suppressions(*ctxt, opts);
+	    group = read_corpus_group_from_input(*ctxt);
+	  }
+	  break;
 	case abigail::tools_utils::FILE_TYPE_RPM:
 	  break;
 	case abigail::tools_utils::FILE_TYPE_SRPM:
@@ -429,6 +456,7 @@ main(int argc, char* argv[])
 
       ABG_ASSERT(env);
       const write_context_sptr ctxt = create_write_context(env, of);
+      set_binary_output(*ctxt, opts.binary_output);
 
       bool is_ok = true;
 
@@ -441,6 +469,8 @@ main(int argc, char* argv[])
 	{
 	  if (type == abigail::tools_utils::FILE_TYPE_XML_CORPUS
 	      ||type == abigail::tools_utils::FILE_TYPE_XML_CORPUS_GROUP
+	      || type == abigail::tools_utils::FILE_TYPE_BINARY_CORPUS
+	      || type == abigail::tools_utils::FILE_TYPE_BINARY_CORPUS_GROUP
 	      || type == abigail::tools_utils::FILE_TYPE_ELF)
 	    {
 	      if (!opts.noout)
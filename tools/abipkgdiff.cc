@@ -30,9 +30,10 @@
 /// devel packages) are extracted concurrently.
 /// There is one thread per package being extracted.  So if there are
 /// 3 thread packages (one package, one debug info package and one
-/// devel package), then there are 3 threads to extracts them.  Then
-/// when the extracting is done, another thread performs the analysis
-/// of th1 extracted content.
+/// devel package), then there are 3 threads to extracts them.  The
+/// thread extracting the package itself then performs the analysis of
+/// its extracted content, while the ancillary packages are still
+/// being extracted.
 ///
 /// 2/ A similar thing is done for the second package.
 ///
@@ -55,7 +56,11 @@
 #include "config.h"
 
 #include <assert.h>
+#include <dirent.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 
 // If fts.h is included before config.h, its indirect inclusions may
@@ -76,6 +81,8 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -97,6 +104,7 @@ using std::string;
 using std::ostream;
 using std::ofstream;
 using std::vector;
+using std::list;
 using std::map;
 using std::unordered_set;
 using std::set;
@@ -148,6 +156,7 @@ using abigail::dwarf_reader::create_read_context;
 using abigail::dwarf_reader::get_soname_of_elf_file;
 using abigail::dwarf_reader::get_type_of_elf_file;
 using abigail::dwarf_reader::read_corpus_from_elf;
+using abigail::dwarf_reader::set_corpus_cache_directory;
 using abigail::xml_writer::create_write_context;
 using abigail::xml_writer::write_context_sptr;
 using abigail::xml_writer::write_corpus;
@@ -179,6 +188,10 @@ public:
   string	devel_package1;
   string	devel_package2;
   size_t	num_workers;
+  size_t	memory_budget;
+  string	report_dir;
+  string	corpus_cache_dir;
+  bool		stream_reports;
   bool		verbose;
   bool		drop_private_types;
   bool		show_relative_offset_changes;
@@ -217,6 +230,8 @@ public:
       nonexistent_file(),
       abignore(true),
       parallel(true),
+      memory_budget(),
+      stream_reports(),
       verbose(),
       drop_private_types(),
       show_relative_offset_changes(true),
@@ -731,11 +746,15 @@ struct compare_args
 {
   const elf_file		elf1;
   const string&		debug_dir1;
-  const suppressions_type	private_types_suppr1;
+  suppressions_type		private_types_suppr1;
   const elf_file		elf2;
   const string&		debug_dir2;
-  const suppressions_type	private_types_suppr2;
+  suppressions_type		private_types_suppr2;
   const options&		opts;
+  // If non-null, the packages which devel packages the private types
+  // suppressions are to be generated from, by the comparison task.
+  const package*		pkg1;
+  const package*		pkg2;
 
   /// Constructor for compare_args, which is used to pass
   /// information to the comparison threads.
@@ -760,7 +779,38 @@ struct compare_args
       private_types_suppr1(priv_types_suppr1),
       elf2(elf2), debug_dir2(debug_dir2),
       private_types_suppr2(priv_types_suppr2),
-      opts(opts)
+      opts(opts), pkg1(), pkg2()
+  {}
+
+  /// Constructor for compare_args, which is used to pass
+  /// information to the comparison threads.
+  ///
+  /// The private types suppressions are generated from the devel
+  /// packages of @p pkg1 and @p pkg2 by the comparison task itself.
+  ///
+  /// @param elf1 the first elf file to consider.
+  ///
+  /// @param debug_dir1 the directory where the debug info file for @p
+  /// elf1 is stored.
+  ///
+  /// @param pkg1 the package of @p elf1.
+  ///
+  /// @param elf2 the second elf file to consider.
+  ///
+  /// @param debug_dir2 the directory where the debug info file for @p
+  /// elf2 is stored.
+  ///
+  /// @param pkg2 the package of @p elf2.
+  ///
+  /// @param opts the options the current program has been called with.
+  compare_args(const elf_file &elf1, const string& debug_dir1,
+	       const package& pkg1,
+	       const elf_file &elf2, const string& debug_dir2,
+	       const package& pkg2,
+	       const options& opts)
+    : elf1(elf1), debug_dir1(debug_dir1),
+      elf2(elf2), debug_dir2(debug_dir2),
+      opts(opts), pkg1(&pkg1), pkg2(&pkg2)
   {}
 }; // end struct compare_args
 
@@ -876,6 +926,14 @@ display_usage(const string& prog_name, ostream& out)
     << " --no-added-binaries            do not display added binaries\n"
     << " --no-abignore                  do not look for *.abignore files\n"
     << " --no-parallel                  do not execute in parallel\n"
+    << " --memory-budget <MiB>          limit the memory used by "
+    "concurrent comparisons\n"
+    << " --stream-reports               emit the report of each binary as "
+    "soon as it's compared\n"
+    << " --report-dir <path>            write the report of each binary "
+    "into its own file under <path>\n"
+    << " --corpus-cache-dir <path>      cache the corpora read from "
+    "binaries in <path>\n"
     << " --fail-no-dbg                  fail if no debug info was found\n"
     << " --show-identical-binaries      show the names of identical binaries\n"
     << " --verbose                      emit verbose progress messages\n"
@@ -897,11 +955,16 @@ display_usage(const string& prog_name, ostream& out)
 ///
 /// @param opts the options passed to the current program.
 ///
+/// @param members_pattern if non-empty, only the members of the
+/// package which path matches this shell pattern are written to
+/// disk.  The rest of the payload is just streamed through.
+///
 /// @return true upon successful completion, false otherwise.
 static bool
 extract_rpm(const string& package_path,
 	    const string& extracted_package_dir_path,
-	    const options &opts)
+	    const options &opts,
+	    const string& members_pattern = "")
 {
   if (opts.verbose)
     emit_prefix("abipkgdiff", cerr)
@@ -915,6 +978,8 @@ extract_rpm(const string& package_path,
     + " || mkdir -p " + extracted_package_dir_path + " ; cd " +
     extracted_package_dir_path + " && rpm2cpio " + package_path +
     " | cpio -dium --quiet";
+  if (!members_pattern.empty())
+    cmd += " '" + members_pattern + "'";
 
   if (system(cmd.c_str()))
     {
@@ -1081,7 +1146,13 @@ extract_package(const package& package,
     {
     case abigail::tools_utils::FILE_TYPE_RPM:
 #ifdef WITH_RPM
-      if (!extract_rpm(package.path(), package.extracted_dir_path(), opts))
+      if (!extract_rpm(package.path(), package.extracted_dir_path(), opts,
+		       package.get_kind() == package::KIND_DEBUG_INFO
+		       // Only the debug info files are used from debug
+		       // info packages.  Their sources, which are often
+		       // bigger, are not extracted.
+		       ? "*/usr/lib/debug/*"
+		       : ""))
         {
           emit_prefix("abipkgdiff", cerr)
 	    << "Error while extracting package " << package.path() << "\n";
@@ -1311,6 +1382,7 @@ compare(const elf_file& elf1,
     add_read_context_suppressions(*c, priv_types_supprs1);
     if (!opts.kabi_suppressions.empty())
       add_read_context_suppressions(*c, opts.kabi_suppressions);
+    set_corpus_cache_directory(*c, opts.corpus_cache_dir);
 
     corpus1 = read_corpus_from_elf(*c, c1_status);
 
@@ -1398,6 +1470,7 @@ compare(const elf_file& elf1,
 
     if (!opts.kabi_suppressions.empty())
       add_read_context_suppressions(*c, opts.kabi_suppressions);
+    set_corpus_cache_directory(*c, opts.corpus_cache_dir);
 
     corpus2 = read_corpus_from_elf(*c, c2_status);
 
@@ -1897,6 +1970,112 @@ maybe_handle_kabi_whitelist_pkg(const package& pkg, options &opts)
   return true;
 }
 
+/// Get the peak resident set size of the current process.
+///
+/// @return the peak resident set size, in bytes, or zero if it could
+/// not be determined.
+static size_t
+get_peak_resident_set_size()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage))
+    return 0;
+  // ru_maxrss is expressed in kilobytes.
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+/// Get the size of the split debug info file of an ELF file of a
+/// package.
+///
+/// The debug info file is looked for under the directory of the
+/// extracted debug info package, at the path of the ELF file relative
+/// to its package.  Its name starts with the name of the ELF file and
+/// ends with ".debug".
+///
+/// @param pkg the package the ELF file belongs to.
+///
+/// @param elf the ELF file to consider.
+///
+/// @param debug_dir the root directory of the debug info files of
+/// @p pkg.
+///
+/// @return the size of the debug info file found, or zero if none
+/// was found.
+static off_t
+get_debug_info_file_size(const package& pkg,
+			 const elf_file& elf,
+			 const string& debug_dir)
+{
+  string relative_path, relative_dir;
+  if (debug_dir.empty()
+      || !pkg.convert_path_to_relative(elf.path, relative_path)
+      || !dir_name(relative_path, relative_dir))
+    return 0;
+
+  string debug_info_dir = debug_dir + "/" + relative_dir;
+  DIR* dir = opendir(debug_info_dir.c_str());
+  if (!dir)
+    return 0;
+
+  off_t result = 0;
+  while (struct dirent* entry = readdir(dir))
+    {
+      string name = entry->d_name;
+      if (name.compare(0, elf.name.size(), elf.name)
+	  || !string_ends_with(name, ".debug"))
+	continue;
+
+      struct stat s;
+      string path = debug_info_dir + "/" + name;
+      if (stat(path.c_str(), &s) == 0 && s.st_size > result)
+	result = s.st_size;
+    }
+  closedir(dir);
+
+  return result;
+}
+
+/// The number of bytes of memory that the comparison of two binaries
+/// is expected to use, per byte of the two binaries and of their
+/// debug info files.
+///
+/// This is a rough estimation of how big an ABI corpus gets, compared
+/// to the size of the DWARF it is built from.
+static const size_t FOOTPRINT_PER_INPUT_BYTE = 8;
+
+/// Estimate the peak memory footprint of the comparison of two ELF
+/// files.
+///
+/// @param pkg1 the package of @p elf1.
+///
+/// @param elf1 the first ELF file to consider.
+///
+/// @param debug_dir1 the root directory of the debug info files of
+/// @p pkg1.
+///
+/// @param pkg2 the package of @p elf2.
+///
+/// @param elf2 the second ELF file to consider.
+///
+/// @param debug_dir2 the root directory of the debug info files of
+/// @p pkg2.
+///
+/// @return the estimated footprint, in bytes.
+static size_t
+estimate_comparison_footprint(const package& pkg1,
+			      const elf_file& elf1,
+			      const string& debug_dir1,
+			      const package& pkg2,
+			      const elf_file& elf2,
+			      const string& debug_dir2)
+{
+  size_t input_size = elf1.size
+    + get_debug_info_file_size(pkg1, elf1, debug_dir1)
+    + elf2.size
+    + get_debug_info_file_size(pkg2, elf2, debug_dir2);
+  return input_size * FOOTPRINT_PER_INPUT_BYTE;
+}
+
 /// The task that performs the extraction of the content of several
 /// packages into a temporary directory.
 ///
@@ -1979,14 +2158,26 @@ public:
   abidiff_status status;
   ostringstream out;
   string pretty_output;
+  // The estimated peak memory footprint of the task, in bytes.
+  size_t estimated_footprint;
+  // Whether the task produced a report.  This is set when the report
+  // has been emitted as soon as the task was done, and hence is no
+  // longer in pretty_output.
+  bool has_emitted_report;
+  // The path of the file the report was written to, if any.
+  string report_path;
 
   compare_task()
-    : status(abigail::tools_utils::ABIDIFF_OK)
+    : status(abigail::tools_utils::ABIDIFF_OK),
+      estimated_footprint(),
+      has_emitted_report()
   {}
 
   compare_task(const compare_args_sptr& a)
     : args(a),
-      status(abigail::tools_utils::ABIDIFF_OK)
+      status(abigail::tools_utils::ABIDIFF_OK),
+      estimated_footprint(),
+      has_emitted_report()
   {}
 
   /// The job performed by the task.
@@ -2003,6 +2194,17 @@ public:
     abigail::dwarf_reader::status detailed_status =
       abigail::dwarf_reader::STATUS_UNKNOWN;
 
+    // The private types suppressions are generated here rather than
+    // when the task is created so that this is done by the workers,
+    // concurrently.  That way, each task also has its own copy of
+    // the suppressions.
+    if (args->pkg1)
+      args->private_types_suppr1 =
+	create_private_types_suppressions(*args->pkg1, args->opts);
+    if (args->pkg2)
+      args->private_types_suppr2 =
+	create_private_types_suppressions(*args->pkg2, args->opts);
+
     status |= compare(args->elf1, args->debug_dir1, args->private_types_suppr1,
 		      args->elf2, args->debug_dir2, args->private_types_suppr2,
 		      args->opts, env, diff, ctxt, &detailed_status);
@@ -2412,7 +2614,7 @@ extract_package_and_map_its_content(const package_sptr &pkg, options &opts)
   pkg_extraction_task_sptr devel_extraction;
   pkg_extraction_task_sptr kabi_whitelist_extraction;
 
-  size_t NUM_EXTRACTIONS = 1;
+  size_t NUM_EXTRACTIONS = 0;
 
   main_pkg_extraction.reset(new pkg_extraction_task(pkg, opts));
 
@@ -2436,24 +2638,43 @@ extract_package_and_map_its_content(const package_sptr &pkg, options &opts)
       ++NUM_EXTRACTIONS;
     }
 
-  size_t num_workers = (opts.parallel
-			? std::min(opts.num_workers, NUM_EXTRACTIONS)
-			: 1);
-  abigail::workers::queue extraction_queue(num_workers);
-
-  // Perform the extraction of the NUM_WORKERS packages in parallel.
-  extraction_queue.schedule_task(dbg_extraction);
-  extraction_queue.schedule_task(main_pkg_extraction);
-  extraction_queue.schedule_task(devel_extraction);
-  extraction_queue.schedule_task(kabi_whitelist_extraction);
-
-  // Wait for the extraction to be done.
-  extraction_queue.wait_for_workers_to_complete();
-
-  // Analyze and map the content of the extracted package.
   bool is_ok = false;
-  if (main_pkg_extraction->is_ok)
-    is_ok = create_maps_of_package_content(*pkg, opts);
+  if (opts.parallel)
+    {
+      size_t num_workers = std::max(std::min(opts.num_workers,
+					     NUM_EXTRACTIONS),
+				    (size_t) 1);
+      abigail::workers::queue extraction_queue(num_workers);
+
+      // Perform the extraction of the ancillary packages in
+      // parallel.
+      extraction_queue.schedule_task(dbg_extraction);
+      extraction_queue.schedule_task(devel_extraction);
+      extraction_queue.schedule_task(kabi_whitelist_extraction);
+
+      // Meanwhile, extract the main package and analyze and map its
+      // content, as that doesn't depend on the ancillary packages.
+      // This way, the mapping overlaps with the extraction of the
+      // debug info packages, which are usually the biggest ones.
+      main_pkg_extraction->perform();
+      if (main_pkg_extraction->is_ok)
+	is_ok = create_maps_of_package_content(*pkg, opts);
+
+      // Wait for the extraction to be done.
+      extraction_queue.wait_for_workers_to_complete();
+    }
+  else
+    {
+      if (dbg_extraction)
+	dbg_extraction->perform();
+      if (devel_extraction)
+	devel_extraction->perform();
+      if (kabi_whitelist_extraction)
+	kabi_whitelist_extraction->perform();
+      main_pkg_extraction->perform();
+      if (main_pkg_extraction->is_ok)
+	is_ok = create_maps_of_package_content(*pkg, opts);
+    }
 
   if (is_ok)
     maybe_handle_kabi_whitelist_pkg(*pkg, opts);
@@ -2555,6 +2776,34 @@ elf_size_is_greater(const task_sptr &task1,
 
 }
 
+/// Compare two comparison tasks by their estimated memory footprint.
+///
+/// When a memory budget is set, this is used to order the tasks from
+/// the most memory hungry to the least, so that the scheduler
+/// considers them in that order.  The estimated footprint also
+/// accounts for the debug info files, which the size of the binaries
+/// doesn't.  Tasks with the same estimated footprint are ordered as
+/// with elf_size_is_greater.
+///
+/// @param task1 the first comparison task to consider.
+///
+/// @param task2 the second comparison task to consider.
+///
+/// @return true if @p task1 is estimated to use more memory than @p
+/// task2.
+bool
+footprint_is_greater(const task_sptr &task1,
+		     const task_sptr &task2)
+{
+  compare_task_sptr t1 = dynamic_pointer_cast<compare_task>(task1);
+  compare_task_sptr t2 = dynamic_pointer_cast<compare_task>(task2);
+
+  if (t1->estimated_footprint != t2->estimated_footprint)
+    return t1->estimated_footprint > t2->estimated_footprint;
+
+  return elf_size_is_greater(task1, task2);
+}
+
 /// This type is used to notify the calling thread that the comparison
 /// of two ELF files is done.
 class comparison_done_notify : public abigail::workers::queue::task_done_notify
@@ -2563,13 +2812,60 @@ class comparison_done_notify : public abigail::workers::queue::task_done_notify
 
 public:
   abi_diff& diff;
+  const options& opts;
   abidiff_status status;
+  // The names of the report files created so far.
+  unordered_set<string> report_file_names;
 
-  comparison_done_notify(abi_diff &d)
+  comparison_done_notify(abi_diff &d, const options& o)
     : diff(d),
+      opts(o),
       status(abigail::tools_utils::ABIDIFF_OK)
   {}
 
+  /// Emit the report of a comparison task that is done, and release
+  /// the memory held by the report.
+  ///
+  /// The report is written into its own file under the report
+  /// directory if the user provided one, or to standard output
+  /// otherwise.
+  ///
+  /// @param t the comparison task to consider.
+  void
+  emit_report(compare_task& t)
+  {
+    if (t.pretty_output.empty())
+      return;
+
+    if (opts.report_dir.empty())
+      cout << t.pretty_output << std::flush;
+    else
+      {
+	// Several binaries can have the same name so make sure each
+	// one gets its own file.
+	string name = t.args->elf1.name;
+	for (unsigned i = 2;
+	     !report_file_names.insert(name).second;
+	     ++i)
+	  {
+	    ostringstream o;
+	    o << t.args->elf1.name << "-" << i;
+	    name = o.str();
+	  }
+
+	t.report_path = opts.report_dir + "/" + name + ".report";
+	ofstream of(t.report_path.c_str(), std::ios_base::trunc);
+	of << t.pretty_output;
+	if (!of.good())
+	  emit_prefix("abipkgdiff", cerr)
+	    << "could not write report to " << t.report_path << "\n";
+      }
+
+    t.has_emitted_report = true;
+    string().swap(t.pretty_output);
+    t.out.str("");
+  }
+
   /// This operator is invoked by the worker queue whenever a
   /// comparison task is done.
   ///
@@ -2585,6 +2881,9 @@ public:
 
     status |= comp_task->status;
 
+    if (opts.stream_reports)
+      emit_report(*comp_task);
+
     if (status != abigail::tools_utils::ABIDIFF_OK)
       {
 	string name = comp_task->args->elf1.name;
@@ -2595,6 +2894,210 @@ public:
   }
 }; // end struct comparison_done_notify
 
+/// This type schedules comparison tasks on a worker queue so that the
+/// estimated memory footprints of the tasks being performed
+/// concurrently add up to no more than a given memory budget.
+///
+/// Tasks are considered from the biggest to the smallest.  When the
+/// biggest pending task doesn't fit in what is left of the budget, a
+/// smaller one that fits is scheduled instead, so that workers don't
+/// sit idle.  A task that doesn't fit in the budget at all is
+/// scheduled only when no other task is being performed.
+///
+/// This type is also the notifier of the worker queue.  It forwards
+/// the notifications to a @ref comparison_done_notify.
+class memory_budget_scheduler
+  : public abigail::workers::queue::task_done_notify
+{
+  memory_budget_scheduler();
+
+  comparison_done_notify&	notifier_;
+  const options&		opts_;
+  size_t			budget_;
+  size_t			max_tasks_in_flight_;
+  size_t			used_;
+  size_t			tasks_in_flight_;
+  pthread_mutex_t		lock_;
+  pthread_cond_t		task_done_cond_;
+
+public:
+  /// Constructor of @ref memory_budget_scheduler.
+  ///
+  /// @param n the notifier to forward task completions to.
+  ///
+  /// @param max_tasks_in_flight the number of workers of the queue
+  /// the tasks are going to be scheduled on.
+  ///
+  /// @param opts the options of the current program.  If its
+  /// memory_budget is zero, tasks are scheduled without any limit.
+  memory_budget_scheduler(comparison_done_notify& n,
+			  size_t max_tasks_in_flight,
+			  const options& opts)
+    : notifier_(n),
+      opts_(opts),
+      budget_(opts.memory_budget),
+      max_tasks_in_flight_(max_tasks_in_flight),
+      used_(),
+      tasks_in_flight_()
+  {
+    pthread_mutex_init(&lock_, /*mutex_attr=*/0);
+    pthread_cond_init(&task_done_cond_, /*cond_attr=*/0);
+  }
+
+  ~memory_budget_scheduler()
+  {
+    pthread_cond_destroy(&task_done_cond_);
+    pthread_mutex_destroy(&lock_);
+  }
+
+  /// Schedule comparison tasks on a worker queue.
+  ///
+  /// This returns when all the tasks have been scheduled; the caller
+  /// must then wait for the queue to complete them.
+  ///
+  /// @param q the queue to schedule the tasks on.  Its notifier must
+  /// be the current instance of @ref memory_budget_scheduler.
+  ///
+  /// @param tasks the comparison tasks to schedule, sorted from the
+  /// biggest to the smallest.
+  void
+  schedule_tasks(abigail::workers::queue& q,
+		 const abigail::workers::queue::tasks_type& tasks)
+  {
+    if (!budget_)
+      {
+	q.schedule_tasks(tasks);
+	return;
+      }
+
+    list<compare_task_sptr> pending;
+    for (abigail::workers::queue::tasks_type::const_iterator i =
+	   tasks.begin();
+	 i != tasks.end();
+	 ++i)
+      pending.push_back(dynamic_pointer_cast<compare_task>(*i));
+
+    pthread_mutex_lock(&lock_);
+    while (!pending.empty())
+      {
+	list<compare_task_sptr>::iterator t = pending.end();
+	if (tasks_in_flight_ < max_tasks_in_flight_)
+	  for (t = pending.begin(); t != pending.end(); ++t)
+	    if (tasks_in_flight_ == 0
+		|| used_ + (*t)->estimated_footprint <= budget_)
+	      break;
+
+	if (t == pending.end())
+	  {
+	    pthread_cond_wait(&task_done_cond_, &lock_);
+	    continue;
+	  }
+
+	used_ += (*t)->estimated_footprint;
+	++tasks_in_flight_;
+	compare_task_sptr task = *t;
+	pending.erase(t);
+
+	pthread_mutex_unlock(&lock_);
+	q.schedule_task(task);
+	pthread_mutex_lock(&lock_);
+      }
+    pthread_mutex_unlock(&lock_);
+  }
+
+  /// This operator is invoked by the worker queue whenever a
+  /// comparison task is done.
+  ///
+  /// It gives the memory budget of the task back and forwards the
+  /// notification.
+  ///
+  /// @param task_done the task that is done.
+  virtual void
+  operator()(const task_sptr& task_done)
+  {
+    notifier_(task_done);
+
+    compare_task_sptr t = dynamic_pointer_cast<compare_task>(task_done);
+    ABG_ASSERT(t);
+
+    if (opts_.verbose && budget_)
+      emit_prefix("abipkgdiff", cerr)
+	<< "compared " << t->args->elf1.name
+	<< ": estimated memory footprint: "
+	<< t->estimated_footprint / (1024 * 1024) << " MiB\n";
+
+    if (!budget_)
+      return;
+
+    pthread_mutex_lock(&lock_);
+    used_ -= t->estimated_footprint;
+    --tasks_in_flight_;
+    pthread_mutex_unlock(&lock_);
+    pthread_cond_signal(&task_done_cond_);
+  }
+
+  /// Emit the peak resident set size of the process along with the
+  /// memory budget, if --verbose was provided.
+  ///
+  /// The comparisons share the address space of the process, so the
+  /// memory used by each of them can't be measured on its own.  This
+  /// is thus called once, after all the tasks are done.
+  void
+  emit_peak_memory_usage() const
+  {
+    if (opts_.verbose && budget_)
+      emit_prefix("abipkgdiff", cerr)
+	<< "memory budget: " << budget_ / (1024 * 1024) << " MiB"
+	<< ", process peak RSS: "
+	<< get_peak_resident_set_size() / (1024 * 1024) << " MiB\n";
+  }
+}; // end class memory_budget_scheduler
+
+/// Emit the index of the reports of comparison tasks that were emitted
+/// as soon as the tasks were done.
+///
+/// The index lists the binaries that have a report, in the order in
+/// which their reports would have been emitted had they not been
+/// emitted as soon as possible, along with where the reports are.
+///
+/// @param done_tasks the comparison tasks that were performed, in the
+/// order of the index.
+///
+/// @param opts the options of the current program.
+static void
+emit_reports_index(const queue::tasks_type& done_tasks, const options& opts)
+{
+  bool emitted_header = false;
+  for (queue::tasks_type::const_iterator i = done_tasks.begin();
+       i != done_tasks.end();
+       ++i)
+    {
+      compare_task_sptr t = dynamic_pointer_cast<compare_task>(*i);
+      if (!t || !t->has_emitted_report)
+	continue;
+
+      if (!emitted_header)
+	{
+	  cout << "Index of reports";
+	  if (!opts.report_dir.empty())
+	    cout << " under " << opts.report_dir;
+	  cout << ":\n";
+	  emitted_header = true;
+	}
+
+      cout << "  " << t->args->elf1.name;
+      if (t->status & abigail::tools_utils::ABIDIFF_ERROR)
+	cout << " (error)";
+      if (!t->report_path.empty())
+	{
+	  string report_name;
+	  base_name(t->report_path, report_name);
+	  cout << ": " << report_name;
+	}
+      cout << "\n";
+    }
+}
+
 /// Erase the temporary directories that might have been created while
 /// handling two packages, unless the user asked to keep the temporary
 /// directories around.
@@ -2675,13 +3178,18 @@ compare_prepared_userspace_packages(package& first_package,
 	      compare_args_sptr args
 		(new compare_args(*it->second,
 				  debug_dir1,
-				  create_private_types_suppressions
-				  (first_package, opts),
+				  first_package,
 				  *iter->second,
 				  debug_dir2,
-				  create_private_types_suppressions
-				  (second_package, opts), opts));
+				  second_package,
+				  opts));
 	      compare_task_sptr t(new compare_task(args));
+	      if (opts.memory_budget)
+		t->estimated_footprint =
+		  estimate_comparison_footprint(first_package, *it->second,
+						debug_dir1,
+						second_package, *iter->second,
+						debug_dir2);
 	      compare_tasks.push_back(t);
 	    }
 	  second_package.path_elf_file_sptr_map().erase(iter);
@@ -2702,8 +3210,15 @@ compare_prepared_userspace_packages(package& first_package,
 
   // Larger elfs are processed first, since it's usually safe to assume
   // their debug-info is larger as well, but the results are still
-  // in a map ordered by looked up in elf.name order.
-  std::sort(compare_tasks.begin(), compare_tasks.end(), elf_size_is_greater);
+  // in a map ordered by looked up in elf.name order.  Under a memory
+  // budget, the tasks are rather ordered by their estimated memory
+  // footprint, which is what the budget is about.
+  if (opts.memory_budget)
+    std::sort(compare_tasks.begin(), compare_tasks.end(),
+	      footprint_is_greater);
+  else
+    std::sort(compare_tasks.begin(), compare_tasks.end(),
+	      elf_size_is_greater);
 
   // There's no reason to spawn more workers than there are ELF pairs
   // to be compared.
@@ -2712,26 +3227,33 @@ compare_prepared_userspace_packages(package& first_package,
 			: 1);
   assert(num_workers >= 1);
 
-  comparison_done_notify notifier(diff);
-  abigail::workers::queue comparison_queue(num_workers, notifier);
+  comparison_done_notify notifier(diff, opts);
+  memory_budget_scheduler scheduler(notifier, num_workers, opts);
+  abigail::workers::queue comparison_queue(num_workers, scheduler);
 
   // Compare all the binaries, in parallel and then wait for the
   // comparisons to complete.
-  comparison_queue.schedule_tasks(compare_tasks);
+  scheduler.schedule_tasks(comparison_queue, compare_tasks);
   comparison_queue.wait_for_workers_to_complete();
+  scheduler.emit_peak_memory_usage();
 
   // Get the set of comparison tasks that were perform and sort them.
   queue::tasks_type& done_tasks = comparison_queue.get_completed_tasks();
   std::sort(done_tasks.begin(), done_tasks.end(), elf_size_is_greater);
 
-  // Print the reports of the comparison to standard output.
-  for (queue::tasks_type::const_iterator i = done_tasks.begin();
-       i != done_tasks.end();
-       ++i)
-    {
-      compare_task_sptr t = dynamic_pointer_cast<compare_task>(*i);
-      cout << t->pretty_output;
-    }
+  // Print the reports of the comparison to standard output, or the
+  // index of the reports if they were emitted as the comparisons
+  // completed.
+  if (opts.stream_reports)
+    emit_reports_index(done_tasks, opts);
+  else
+    for (queue::tasks_type::const_iterator i = done_tasks.begin();
+	 i != done_tasks.end();
+	 ++i)
+      {
+	compare_task_sptr t = dynamic_pointer_cast<compare_task>(*i);
+	cout << t->pretty_output;
+      }
 
   // Update the count of added binaries.
   for (map<string, elf_file_sptr>::iterator it =
@@ -2839,6 +3361,10 @@ self_compare_prepared_userspace_package(package&	pkg,
 				  supprs,
 				  opts));
 	      self_compare_task_sptr t(new self_compare_task(args));
+	      if (opts.memory_budget)
+		t->estimated_footprint =
+		  estimate_comparison_footprint(pkg, *it->second, debug_dir,
+						pkg, *it->second, debug_dir);
 	      self_compare_tasks.push_back(t);
 	    }
 	}
@@ -2852,10 +3378,17 @@ self_compare_prepared_userspace_package(package&	pkg,
 
   // Larger elfs are processed first, since it's usually safe to assume
   // their debug-info is larger as well, but the results are still
-  // in a map ordered by looked up in elf.name order.
-  std::sort(self_compare_tasks.begin(),
-	    self_compare_tasks.end(),
-	    elf_size_is_greater);
+  // in a map ordered by looked up in elf.name order.  Under a memory
+  // budget, the tasks are rather ordered by their estimated memory
+  // footprint, which is what the budget is about.
+  if (opts.memory_budget)
+    std::sort(self_compare_tasks.begin(),
+	      self_compare_tasks.end(),
+	      footprint_is_greater);
+  else
+    std::sort(self_compare_tasks.begin(),
+	      self_compare_tasks.end(),
+	      elf_size_is_greater);
 
   // There's no reason to spawn more workers than there are ELF pairs
   // to be compared.
@@ -2864,27 +3397,35 @@ self_compare_prepared_userspace_package(package&	pkg,
 			: 1);
   assert(num_workers >= 1);
 
-  comparison_done_notify notifier(diff);
-  abigail::workers::queue comparison_queue(num_workers, notifier);
+  comparison_done_notify notifier(diff, opts);
+  memory_budget_scheduler scheduler(notifier, num_workers, opts);
+  abigail::workers::queue comparison_queue(num_workers, scheduler);
 
   // Compare all the binaries, in parallel and then wait for the
   // comparisons to complete.
-  comparison_queue.schedule_tasks(self_compare_tasks);
+  scheduler.schedule_tasks(comparison_queue, self_compare_tasks);
   comparison_queue.wait_for_workers_to_complete();
+  scheduler.emit_peak_memory_usage();
 
   // Get the set of comparison tasks that were perform and sort them.
   queue::tasks_type& done_tasks = comparison_queue.get_completed_tasks();
   std::sort(done_tasks.begin(), done_tasks.end(), elf_size_is_greater);
 
-  // Print the reports of the comparison to standard output.
-  for (queue::tasks_type::const_iterator i = done_tasks.begin();
-       i != done_tasks.end();
-       ++i)
-    {
-      self_compare_task_sptr t = dynamic_pointer_cast<self_compare_task>(*i);
-      if (t)
-	cout << t->pretty_output;
-    }
+  // Print the reports of the comparison to standard output, or the
+  // index of the reports if they were emitted as the comparisons
+  // completed.
+  if (opts.stream_reports)
+    emit_reports_index(done_tasks, opts);
+  else
+    for (queue::tasks_type::const_iterator i = done_tasks.begin();
+	 i != done_tasks.end();
+	 ++i)
+      {
+	self_compare_task_sptr t =
+	  dynamic_pointer_cast<self_compare_task>(*i);
+	if (t)
+	  cout << t->pretty_output;
+      }
 
   // Erase temporary directory tree we might have left behind.
   maybe_erase_temp_dirs(pkg, pkg, opts);
@@ -3280,6 +3821,53 @@ parse_command_line(int argc, char* argv[], options& opts)
 	opts.abignore = false;
       else if (!strcmp(argv[i], "--no-parallel"))
 	opts.parallel = false;
+      else if (!strcmp(argv[i], "--memory-budget"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  char *end = 0;
+	  unsigned long mib = strtoul(argv[j], &end, 10);
+	  if (!*argv[j] || *end || !mib
+	      || mib > std::numeric_limits<size_t>::max() / (1024 * 1024))
+	    {
+	      opts.wrong_arg = argv[j];
+	      return false;
+	    }
+	  opts.memory_budget = mib * 1024 * 1024;
+	  ++i;
+	}
+      else if (!strcmp(argv[i], "--stream-reports"))
+	opts.stream_reports = true;
+      else if (!strcmp(argv[i], "--report-dir"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  opts.report_dir = make_path_absolute(argv[j]).get();
+	  opts.stream_reports = true;
+	  ++i;
+	}
+      else if (!strcmp(argv[i], "--corpus-cache-dir"))
+	{
+	  int j = i + 1;
+	  if (j >= argc)
+	    {
+	      opts.missing_operand = true;
+	      opts.wrong_option = argv[i];
+	      return true;
+	    }
+	  opts.corpus_cache_dir = make_path_absolute(argv[j]).get();
+	  ++i;
+	}
       else if (!strcmp(argv[i], "--show-identical-binaries"))
 	opts.show_identical_binaries = true;
       else if (!strcmp(argv[i], "--self-check"))
@@ -3412,6 +4000,14 @@ main(int argc, char* argv[])
       return 0;
     }
 
+  if (!opts.report_dir.empty() && !ensure_dir_path_created(opts.report_dir))
+    {
+      emit_prefix("abipkgdiff", cerr)
+	<< "could not create the report directory "
+	<< opts.report_dir << "\n";
+      return abigail::tools_utils::ABIDIFF_ERROR;
+    }
+
     if (!opts.no_default_suppression && opts.suppression_paths.empty())
     {
       // Load the default system and user suppressions.